@@ -0,0 +1,246 @@
+#include <stdexcept>
+
+namespace Batch
+{
+
+/**
+	Values per batch. A batch of up to 8 byte values (16 KiB) and its selection vector stay in L1/L2
+	while they pass through filter, project and aggregate.
+*/
+const size_t BATCH_SIZE = 2048;
+
+/**
+	Positions of the active values of a batch, ascending. Filters shrink it in place.
+*/
+struct selection {
+	std::vector<uint32_t> indices;
+	size_t count = 0;
+
+	void reset(size_t size) {
+		indices.resize(BATCH_SIZE);
+		for (size_t i = 0; i < size; ++i) {
+			indices[i] = i;
+		}
+		count = size;
+	}
+};
+
+// ---------------------- SCANS ------------------ //
+
+/**
+	Scans decode the next batch of a compressed column into a buffer owned by the caller and return the number
+	of values, 0 at the end of the column. Every batch but the last holds exactly BATCH_SIZE rows, so scans
+	over different columns of a table stay aligned. The buffer is reused, its capacity never exceeds BATCH_SIZE.
+*/
+template <typename D, typename C>
+class DictionaryScan
+{
+public:
+	using value_type = D;
+
+	DictionaryScan(const std::pair<std::vector<D>, std::vector<C>> &compressed) : compressed(compressed) { }
+
+	size_t next(std::vector<D> &values) {
+		size_t n = std::min(BATCH_SIZE, compressed.second.size() - position);
+		values.resize(n);
+		const auto *codes = compressed.second.data() + position;
+		for (size_t i = 0; i < n; ++i) {
+			values[i] = compressed.first[codes[i]];
+		}
+		position += n;
+		return n;
+	}
+
+	void rewind() { position = 0; }
+
+private:
+	const std::pair<std::vector<D>, std::vector<C>> &compressed;
+	size_t position = 0;
+};
+
+template <typename D>
+class BlockLocalScan
+{
+public:
+	using value_type = D;
+
+	BlockLocalScan(const BlockLocal::compressedData<D> &compressed) : compressed(compressed) { }
+
+	size_t next(std::vector<D> &values) {
+		size_t n = std::min(BATCH_SIZE, compressed.size - position);
+		values.resize(n);
+		for (size_t i = 0; i < n;) {
+			const auto &b = compressed.blocks[(position + i) / compressed.blockSize];
+			size_t offset = (position + i) % compressed.blockSize;
+			size_t run = std::min(n - i, b.size() - offset);
+			BlockLocal::with_codes(b, [&](const auto &codes) {
+				for (size_t j = 0; j < run; ++j) {
+					values[i + j] = b.dictionary[codes[offset + j]];
+				}
+			});
+			i += run;
+		}
+		position += n;
+		return n;
+	}
+
+	void rewind() { position = 0; }
+
+private:
+	const BlockLocal::compressedData<D> &compressed;
+	size_t position = 0;
+};
+
+/**
+	Huffman blocks hold a variable number of values, a decoded block that does not fit into the batch
+	is kept in a small pending buffer for the next one.
+*/
+template <typename D, std::size_t SIZE>
+class HuffmanScan
+{
+public:
+	using value_type = D;
+
+	HuffmanScan(const Huffman::compressedData<D, SIZE> &column)
+		: column(column), reverseDictionary(Huffman::getReverseDictionary(column.dictionary)) { }
+
+	size_t next(std::vector<D> &values) {
+		values.clear();
+		values.reserve(BATCH_SIZE);
+		while (values.size() < BATCH_SIZE) {
+			if (pendingPosition == pending.size()) {
+				if (block == column.compressed.size()) {
+					break;
+				}
+				pending.clear();
+				pendingPosition = 0;
+				Huffman::decompressBlock(column.compressed[block++], reverseDictionary, pending);
+				continue;
+			}
+			size_t n = std::min(BATCH_SIZE - values.size(), pending.size() - pendingPosition);
+			values.insert(values.end(), pending.begin() + pendingPosition, pending.begin() + pendingPosition + n);
+			pendingPosition += n;
+		}
+		return values.size();
+	}
+
+	void rewind() {
+		block = 0;
+		pending.clear();
+		pendingPosition = 0;
+	}
+
+private:
+	const Huffman::compressedData<D, SIZE> &column;
+	std::unordered_map<std::bitset<SIZE>, D> reverseDictionary;
+	size_t block = 0;
+	std::vector<D> pending;
+	size_t pendingPosition = 0;
+};
+
+// ---------------------- OPERATORS ------------------ //
+
+/**
+	Keeps the selected values matching the predicate. Branch free: every index is written, only matches advance.
+*/
+template <typename D, typename P>
+void filter(const std::vector<D> &values, selection &selected, P predicate) {
+	size_t count = 0;
+	for (size_t i = 0; i < selected.count; ++i) {
+		auto index = selected.indices[i];
+		selected.indices[count] = index;
+		count += predicate(values[index]) ? 1 : 0;
+	}
+	selected.count = count;
+}
+
+/**
+	Writes fn(value) of every selected value densely into out.
+*/
+template <typename D, typename R, typename F>
+void project(const std::vector<D> &values, const selection &selected, F fn, std::vector<R> &out) {
+	out.resize(selected.count);
+	for (size_t i = 0; i < selected.count; ++i) {
+		out[i] = fn(values[selected.indices[i]]);
+	}
+}
+
+template <typename D>
+double sum(const std::vector<D> &values, const selection &selected) {
+	double result = 0;
+	for (size_t i = 0; i < selected.count; ++i) {
+		result += values[selected.indices[i]];
+	}
+	return result;
+}
+
+// ---------------------- PIPELINES ------------------ //
+
+/**
+	scan -> filter -> consume(values, selected) for every batch. Memory use is a few batches, independent of the column size.
+*/
+template <typename S, typename P, typename F>
+void for_each_where(S &scan, P predicate, F consume) {
+	std::vector<typename S::value_type> values;
+	selection selected;
+	while (size_t n = scan.next(values)) {
+		selected.reset(n);
+		filter(values, selected, predicate);
+		consume(values, selected);
+	}
+}
+
+template <typename S, typename P>
+size_t count_where(S &scan, P predicate) {
+	size_t count = 0;
+	for_each_where(scan, predicate, [&count](const auto &values, const selection &selected) {
+		count += selected.count;
+	});
+	return count;
+}
+
+template <typename S, typename P>
+double sum_where(S &scan, P predicate) {
+	double result = 0;
+	for_each_where(scan, predicate, [&result](const auto &values, const selection &selected) {
+		result += sum(values, selected);
+	});
+	return result;
+}
+
+/**
+	SUM(valueScan) WHERE predicate(filterScan): both scans advance in lockstep over the same rows,
+	the selection of the filter column picks the values of the other.
+*/
+template <typename S, typename T, typename P>
+double sum_where(S &filterScan, P predicate, T &valueScan) {
+	std::vector<typename S::value_type> filterValues;
+	std::vector<typename T::value_type> values;
+	selection selected;
+	double result = 0;
+	while (size_t n = filterScan.next(filterValues)) {
+		if (valueScan.next(values) != n) {
+			throw std::logic_error("Scans over columns of different length");
+		}
+		selected.reset(n);
+		filter(filterValues, selected, predicate);
+		result += sum(values, selected);
+	}
+	return result;
+}
+
+/**
+	Matching values of the column, collected batch by batch (the only full-size result).
+*/
+template <typename S, typename P>
+std::vector<typename S::value_type> where(S &scan, P predicate) {
+	std::vector<typename S::value_type> result;
+	std::vector<typename S::value_type> projected;
+	for_each_where(scan, predicate, [&](const auto &values, const selection &selected) {
+		project(values, selected, [](const auto &value) { return value; }, projected);
+		result.insert(result.end(), projected.begin(), projected.end());
+	});
+	return result;
+}
+
+} // end namespace Batch
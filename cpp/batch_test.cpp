@@ -0,0 +1,95 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <queue>
+#include <cassert>
+#include <cmath>
+#include <bitset>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "blocklocal.cpp"
+#include "huffman.cpp"
+#include "batch.cpp"
+
+int main(int argc, char const *argv[])
+{
+	// Not a multiple of the batch size
+	std::vector<int> price;
+	std::vector<int> day;
+	for (int i = 0; i < 10000; ++i) {
+		price.push_back((i * 7919) % 1000);
+		day.push_back(i / 40);
+	}
+	auto compressedPrice = Dictionary::compress<int, uint16_t>(price);
+	auto compressedDay = Dictionary::compress<int, uint8_t>(day);
+	auto blockLocalPrice = BlockLocal::compress(price, 3000);
+	Huffman::compressedData<int, 64> huffmanPrice;
+	auto compressedColumn = Huffman::compress<int, 64>(price);
+	huffmanPrice.dictionary = std::get<0>(compressedColumn);
+	huffmanPrice.compressed = std::get<1>(compressedColumn);
+	huffmanPrice.bounds = std::get<2>(compressedColumn);
+	auto predicate = [](int v) { return v < 300; };
+	std::cout << "#### TEST SCANS ####" << std::endl;
+	{
+		Batch::DictionaryScan<int, uint16_t> dictionaryScan(compressedPrice);
+		Batch::BlockLocalScan<int> blockLocalScan(blockLocalPrice);
+		Batch::HuffmanScan<int, 64> huffmanScan(huffmanPrice);
+		std::vector<int> a, b, c;
+		std::vector<int> all;
+		size_t batches = 0;
+		while (size_t n = dictionaryScan.next(a)) {
+			assert(n == (batches < 4 ? Batch::BATCH_SIZE : 10000 - 4 * Batch::BATCH_SIZE));
+			assert(blockLocalScan.next(b) == n && huffmanScan.next(c) == n);
+			assert(a == b && a == c);
+			assert(c.capacity() <= Batch::BATCH_SIZE);
+			all.insert(all.end(), a.begin(), a.end());
+			++batches;
+		}
+		assert(batches == 5 && all == price);
+		assert(blockLocalScan.next(b) == 0 && huffmanScan.next(c) == 0);
+		huffmanScan.rewind();
+		assert(huffmanScan.next(c) == Batch::BATCH_SIZE && c[0] == price[0]);
+	}
+	std::cout << "#### TEST PIPELINES ####" << std::endl;
+	{
+		std::function<bool (int)> function = predicate;
+		size_t expectedCount = Dictionary::count_where_op(compressedPrice, function);
+		double expectedSum = 0;
+		double expectedDaySum = 0;
+		for (size_t i = 0; i < price.size(); ++i) {
+			expectedSum += predicate(price[i]) ? price[i] : 0;
+			expectedDaySum += day[i] < 100 ? price[i] : 0;
+		}
+		Batch::DictionaryScan<int, uint16_t> dictionaryScan(compressedPrice);
+		assert(Batch::count_where(dictionaryScan, predicate) == expectedCount);
+		Batch::HuffmanScan<int, 64> huffmanScan(huffmanPrice);
+		assert(Batch::sum_where(huffmanScan, predicate) == expectedSum);
+		Batch::BlockLocalScan<int> blockLocalScan(blockLocalPrice);
+		assert(Batch::where(blockLocalScan, predicate) == Dictionary::where_copy_op(compressedPrice, function));
+
+		// SUM(price) WHERE day < 100
+		Batch::DictionaryScan<int, uint8_t> dayScan(compressedDay);
+		huffmanScan.rewind();
+		assert(Batch::sum_where(dayScan, [](int v) { return v < 100; }, huffmanScan) == expectedDaySum);
+
+		std::vector<int> shortColumn = {1, 2, 3};
+		auto compressedShort = Dictionary::compress<int, uint8_t>(shortColumn);
+		Batch::DictionaryScan<int, uint8_t> shortScan(compressedShort);
+		dayScan.rewind();
+		bool thrown = false;
+		try {
+			Batch::sum_where(dayScan, predicate, shortScan);
+		}
+		catch (const std::logic_error &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	return 0;
+}
@@ -0,0 +1,332 @@
+#include <stdexcept>
+
+namespace BitmapIndex
+{
+
+/**
+	Rows are split into chunks of 2^16, the low 16 bits of a row address it within its chunk.
+	A chunk with at most ARRAY_MAX rows is stored as sorted array (2 bytes per row), a denser one
+	as bitmap of 2^16 bits (8 KiB, the size of a full array).
+*/
+const size_t CHUNK_BITS = 16;
+const size_t ARRAY_MAX = 4096;
+const size_t BITMAP_WORDS = (size_t(1) << CHUNK_BITS) / 64;
+
+/**
+	Rows of one chunk, either in array or in bitmap.
+*/
+struct container {
+	uint32_t key = 0;
+	size_t cardinality = 0;
+	std::vector<uint16_t> array;
+	std::vector<uint64_t> bitmap;
+
+	bool isBitmap() const { return !bitmap.empty(); }
+	bool contains(uint16_t low) const {
+		if (isBitmap()) {
+			return (bitmap[low / 64] >> (low % 64)) & 1;
+		}
+		return std::binary_search(array.begin(), array.end(), low);
+	}
+};
+
+/**
+	Compressed set of row ids, containers sorted by key (Roaring bitmap).
+*/
+struct roaring {
+	std::vector<container> containers;
+
+	size_t cardinality() const {
+		size_t count = 0;
+		for (const auto &c : containers) {
+			count += c.cardinality;
+		}
+		return count;
+	}
+};
+
+/**
+	One roaring bitmap of rows per dictionary code: bitmaps[code] holds every row with that code.
+	Meant for low-cardinality columns, every distinct value costs at least one container.
+*/
+struct index {
+	std::vector<roaring> bitmaps;
+	size_t rows = 0;
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+/**
+	Turns an array container with more than ARRAY_MAX rows into a bitmap and a bitmap with at most ARRAY_MAX rows into an array.
+*/
+void normalize(container &c) {
+	if (!c.isBitmap() && c.cardinality > ARRAY_MAX) {
+		c.bitmap.assign(BITMAP_WORDS, 0);
+		for (auto low : c.array) {
+			c.bitmap[low / 64] |= uint64_t(1) << (low % 64);
+		}
+		c.array.clear();
+		c.array.shrink_to_fit();
+	}
+	else if (c.isBitmap() && c.cardinality <= ARRAY_MAX) {
+		c.array.clear();
+		for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+			for (uint64_t word = c.bitmap[w]; word; word &= word - 1) {
+				c.array.push_back(w * 64 + __builtin_ctzll(word));
+			}
+		}
+		c.bitmap.clear();
+		c.bitmap.shrink_to_fit();
+	}
+}
+
+/**
+	Appends a row, rows have to be added in ascending order.
+*/
+void append(roaring &bitmap, size_t row) {
+	uint32_t key = row >> CHUNK_BITS;
+	uint16_t low = row & ((size_t(1) << CHUNK_BITS) - 1);
+	if (bitmap.containers.empty() || bitmap.containers.back().key != key) {
+		container c;
+		c.key = key;
+		bitmap.containers.push_back(std::move(c));
+	}
+	auto &c = bitmap.containers.back();
+	if (c.isBitmap()) {
+		c.bitmap[low / 64] |= uint64_t(1) << (low % 64);
+	}
+	else {
+		c.array.push_back(low);
+	}
+	++c.cardinality;
+	if (!c.isBitmap() && c.cardinality > ARRAY_MAX) {
+		normalize(c);
+	}
+}
+
+container intersect(const container &a, const container &b) {
+	container result;
+	result.key = a.key;
+	if (a.isBitmap() && b.isBitmap()) {
+		result.bitmap.resize(BITMAP_WORDS);
+		for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+			result.bitmap[w] = a.bitmap[w] & b.bitmap[w];
+			result.cardinality += __builtin_popcountll(result.bitmap[w]);
+		}
+	}
+	else if (a.isBitmap() || b.isBitmap()) {
+		const auto &array = a.isBitmap() ? b : a;
+		const auto &bitmap = a.isBitmap() ? a : b;
+		for (auto low : array.array) {
+			if (bitmap.contains(low)) {
+				result.array.push_back(low);
+			}
+		}
+		result.cardinality = result.array.size();
+	}
+	else {
+		std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result.array));
+		result.cardinality = result.array.size();
+	}
+	normalize(result);
+	return result;
+}
+
+container unite(const container &a, const container &b) {
+	container result;
+	result.key = a.key;
+	if (!a.isBitmap() && !b.isBitmap() && a.cardinality + b.cardinality <= ARRAY_MAX) {
+		std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result.array));
+		result.cardinality = result.array.size();
+		return result;
+	}
+	result.bitmap.assign(BITMAP_WORDS, 0);
+	for (const auto *c : {&a, &b}) {
+		if (c->isBitmap()) {
+			for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+				result.bitmap[w] |= c->bitmap[w];
+			}
+		}
+		else {
+			for (auto low : c->array) {
+				result.bitmap[low / 64] |= uint64_t(1) << (low % 64);
+			}
+		}
+	}
+	for (auto word : result.bitmap) {
+		result.cardinality += __builtin_popcountll(word);
+	}
+	normalize(result);
+	return result;
+}
+
+// ---------------------- BUILD ------------------ //
+
+/**
+	Builds the index of a Dictionary compressed column (see Dictionary::compress) with one pass over the attribute vector.
+*/
+template <typename D, typename C>
+index build(const std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	index result;
+	result.rows = compressed.second.size();
+	result.bitmaps.resize(compressed.first.size());
+	for (size_t row = 0; row < compressed.second.size(); ++row) {
+		append(result.bitmaps[compressed.second[row]], row);
+	}
+	return result;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	AND: containers with the same key are intersected, all others dropped.
+*/
+roaring intersect(const roaring &a, const roaring &b) {
+	roaring result;
+	auto i = a.containers.begin();
+	auto j = b.containers.begin();
+	while (i != a.containers.end() && j != b.containers.end()) {
+		if (i->key < j->key) {
+			++i;
+		}
+		else if (j->key < i->key) {
+			++j;
+		}
+		else {
+			auto c = intersect(*i++, *j++);
+			if (c.cardinality > 0) {
+				result.containers.push_back(std::move(c));
+			}
+		}
+	}
+	return result;
+}
+
+/**
+	OR: containers with the same key are united, all others copied.
+*/
+roaring unite(const roaring &a, const roaring &b) {
+	roaring result;
+	auto i = a.containers.begin();
+	auto j = b.containers.begin();
+	while (i != a.containers.end() || j != b.containers.end()) {
+		if (j == b.containers.end() || (i != a.containers.end() && i->key < j->key)) {
+			result.containers.push_back(*i++);
+		}
+		else if (i == a.containers.end() || j->key < i->key) {
+			result.containers.push_back(*j++);
+		}
+		else {
+			result.containers.push_back(unite(*i++, *j++));
+		}
+	}
+	return result;
+}
+
+/**
+	Rows equal to value. Empty if the value is not in the dictionary.
+*/
+template <typename D>
+roaring equal(const index &idx, const std::vector<D> &dictionary, const D &value) {
+	auto it = std::lower_bound(dictionary.begin(), dictionary.end(), value);
+	if (it == dictionary.end() || !(*it == value)) {
+		return roaring();
+	}
+	return idx.bitmaps[it - dictionary.begin()];
+}
+
+/**
+	Rows whose value is in values: OR of the bitmaps of all their codes.
+*/
+template <typename D>
+roaring in(const index &idx, const std::vector<D> &dictionary, const std::vector<D> &values) {
+	roaring result;
+	for (const auto &value : values) {
+		result = unite(result, equal(idx, dictionary, value));
+	}
+	return result;
+}
+
+/**
+	Number of rows equal to value, the cardinality kept in the containers.
+*/
+template <typename D>
+size_t count_where_op_equal(const index &idx, const std::vector<D> &dictionary, const D &value) {
+	auto it = std::lower_bound(dictionary.begin(), dictionary.end(), value);
+	if (it == dictionary.end() || !(*it == value)) {
+		return 0;
+	}
+	return idx.bitmaps[it - dictionary.begin()].cardinality();
+}
+
+/**
+	Number of rows whose value is in values. Every row has exactly one code, so the bitmaps of different codes never overlap.
+*/
+template <typename D>
+size_t count_where_op_in(const index &idx, const std::vector<D> &dictionary, std::vector<D> values) {
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+	size_t count = 0;
+	for (const auto &value : values) {
+		count += count_where_op_equal(idx, dictionary, value);
+	}
+	return count;
+}
+
+/**
+	Conjunction of predicates, possibly on different columns of the same table: AND of their bitmaps,
+	smallest first so the intermediate results stay small.
+*/
+roaring conjunction(std::vector<roaring> bitmaps) {
+	if (bitmaps.empty()) {
+		throw std::invalid_argument("Conjunction of no predicates");
+	}
+	std::sort(bitmaps.begin(), bitmaps.end(), [](const roaring &a, const roaring &b) {
+		return a.cardinality() < b.cardinality();
+	});
+	roaring result = bitmaps[0];
+	for (size_t i = 1; i < bitmaps.size() && !result.containers.empty(); ++i) {
+		result = intersect(result, bitmaps[i]);
+	}
+	return result;
+}
+
+/**
+	Row ids in ascending order, e.g. for Dictionary::partial_decompress.
+*/
+std::vector<size_t> rows(const roaring &bitmap) {
+	std::vector<size_t> result;
+	result.reserve(bitmap.cardinality());
+	for (const auto &c : bitmap.containers) {
+		size_t high = size_t(c.key) << CHUNK_BITS;
+		if (c.isBitmap()) {
+			for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+				for (uint64_t word = c.bitmap[w]; word; word &= word - 1) {
+					result.push_back(high + w * 64 + __builtin_ctzll(word));
+				}
+			}
+		}
+		else {
+			for (auto low : c.array) {
+				result.push_back(high + low);
+			}
+		}
+	}
+	return result;
+}
+
+/**
+	Size of the index in bytes.
+*/
+size_t sizeInBytes(const index &idx) {
+	size_t size = sizeof(idx);
+	for (const auto &bitmap : idx.bitmaps) {
+		size += sizeof(bitmap);
+		for (const auto &c : bitmap.containers) {
+			size += sizeof(c) + c.array.size() * sizeof(uint16_t) + c.bitmap.size() * sizeof(uint64_t);
+		}
+	}
+	return size;
+}
+
+} // end namespace BitmapIndex
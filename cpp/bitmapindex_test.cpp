@@ -0,0 +1,79 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "bitmapindex.cpp"
+
+int main(int argc, char const *argv[])
+{
+	// 3 chunks: status is dense ("F" in the first chunk only), priority sparse and spread
+	const size_t rows = 150000;
+	std::vector<std::string> status;
+	std::vector<int> priority;
+	for (size_t i = 0; i < rows; ++i) {
+		status.push_back(i < 65536 ? "F" : (i % 3 == 0 ? "P" : "O"));
+		priority.push_back(i % 1000 == 0 ? 1 : (int)(i % 5) + 2);
+	}
+	auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+	auto compressedPriority = Dictionary::compress<int, uint8_t>(priority);
+	auto statusIndex = BitmapIndex::build(compressedStatus);
+	auto priorityIndex = BitmapIndex::build(compressedPriority);
+	std::cout << "#### TEST BUILD ####" << std::endl;
+	{
+		const auto &f = statusIndex.bitmaps[0];
+		assert(f.containers.size() == 1 && f.containers[0].isBitmap() && f.cardinality() == 65536);
+		const auto &one = priorityIndex.bitmaps[0];
+		assert(one.containers.size() == 3 && !one.containers[0].isBitmap() && one.cardinality() == 150);
+		size_t total = 0;
+		for (const auto &bitmap : priorityIndex.bitmaps) {
+			total += bitmap.cardinality();
+		}
+		assert(total == rows);
+	}
+	std::cout << "#### TEST OPS ####" << std::endl;
+	{
+		for (std::string value : {"F", "O", "P", "X"}) {
+			size_t expected = std::count(status.begin(), status.end(), value);
+			assert(BitmapIndex::count_where_op_equal(statusIndex, compressedStatus.first, value) == expected);
+			assert(BitmapIndex::equal(statusIndex, compressedStatus.first, value).cardinality() == expected);
+		}
+		std::vector<int> list = {1, 3, 3, 9};
+		size_t expectedIn = std::count_if(priority.begin(), priority.end(), [](int v) { return v == 1 || v == 3; });
+		assert(BitmapIndex::count_where_op_in(priorityIndex, compressedPriority.first, list) == expectedIn);
+		auto inRows = BitmapIndex::rows(BitmapIndex::in(priorityIndex, compressedPriority.first, list));
+		assert(inRows.size() == expectedIn && std::is_sorted(inRows.begin(), inRows.end()));
+
+		// status = 'P' AND priority IN (1, 3)
+		auto matches = BitmapIndex::conjunction({BitmapIndex::equal(statusIndex, compressedStatus.first, std::string("P")),
+		                                         BitmapIndex::in(priorityIndex, compressedPriority.first, list)});
+		std::vector<size_t> expectedRows;
+		for (size_t i = 0; i < rows; ++i) {
+			if (status[i] == "P" && (priority[i] == 1 || priority[i] == 3)) {
+				expectedRows.push_back(i);
+			}
+		}
+		assert(BitmapIndex::rows(matches) == expectedRows);
+		assert(matches.cardinality() == expectedRows.size());
+		// Dense AND dense: bitmap containers on both sides
+		auto dense = BitmapIndex::conjunction({statusIndex.bitmaps[0], BitmapIndex::in(priorityIndex, compressedPriority.first, {2, 3, 4})});
+		assert(dense.cardinality() == (size_t)std::count_if(priority.begin(), priority.begin() + 65536, [](int v) { return v >= 2 && v <= 4; }));
+
+		bool thrown = false;
+		try {
+			BitmapIndex::conjunction({});
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	return 0;
+}
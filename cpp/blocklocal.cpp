@@ -0,0 +1,312 @@
+#include <stdexcept>
+#include <type_traits>
+
+namespace BlockLocal
+{
+
+/**
+	Rows per block. At most 2^16 rows keep every block dictionary addressable with 2 byte codes
+	and small enough to stay in L1/L2 while a block is decoded.
+*/
+const size_t BLOCK_SIZE = 1 << 16;
+
+/**
+	One block of rows with its own sorted dictionary:
+		- Codes are 1 byte if the block has at most 2^8 uniques, 2 bytes otherwise
+		- globalIds[code] is the index of dictionary[code] in the global dictionary (only if requested)
+*/
+template <typename D>
+struct block {
+	std::vector<D> dictionary;
+	bool wide = false;
+	std::vector<uint8_t> narrowCodes;
+	std::vector<uint16_t> wideCodes;
+	std::vector<uint32_t> globalIds;
+
+	size_t size() const { return wide ? wideCodes.size() : narrowCodes.size(); }
+	uint16_t code(size_t i) const { return wide ? wideCodes[i] : narrowCodes[i]; }
+};
+
+/**
+	A column split into blocks of blockSize rows. globalDictionary is the sorted union of all block
+	dictionaries and only built if global ids were requested (joins, group-bys).
+*/
+template <typename D>
+struct compressedData {
+	std::vector<block<D>> blocks;
+	size_t blockSize = BLOCK_SIZE;
+	size_t size = 0;
+	std::vector<D> globalDictionary;
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+template <typename D, typename T>
+void encodeBlock(typename std::vector<D>::const_iterator first, typename std::vector<D>::const_iterator last,
+                 const std::vector<D> &dictionary, std::vector<T> &codes) {
+	std::unordered_map<D, T> lookup(dictionary.size());
+	T j = 0;
+	for (const auto &key : dictionary) {
+		lookup[key] = j;
+		++j;
+	}
+	codes.reserve(last - first);
+	for (auto it = first; it != last; ++it) {
+		codes.push_back(lookup[*it]);
+	}
+}
+
+template <typename D, typename T>
+void decodeBlock(const std::vector<D> &dictionary, const std::vector<T> &codes, std::vector<D> &out) {
+	for (auto code : codes) {
+		out.push_back(dictionary[code]);
+	}
+}
+
+/**
+	Calls fn(codes) with the codes of the block in their stored width.
+*/
+template <typename D, typename F>
+void with_codes(const block<D> &b, F fn) {
+	if (b.wide) {
+		fn(b.wideCodes);
+	}
+	else {
+		fn(b.narrowCodes);
+	}
+}
+
+/**
+	Maps every block dictionary onto the sorted union of all of them. Block dictionaries are sorted,
+	so one merge walk per block is enough.
+*/
+template <typename D>
+void buildGlobalIds(compressedData<D> &compressed) {
+	auto &global = compressed.globalDictionary;
+	for (const auto &b : compressed.blocks) {
+		global.insert(global.end(), b.dictionary.begin(), b.dictionary.end());
+	}
+	std::sort(global.begin(), global.end());
+	global.erase(std::unique(global.begin(), global.end()), global.end());
+	for (auto &b : compressed.blocks) {
+		b.globalIds.resize(b.dictionary.size());
+		size_t g = 0;
+		for (size_t code = 0; code < b.dictionary.size(); ++code) {
+			while (global[g] < b.dictionary[code]) {
+				++g;
+			}
+			b.globalIds[code] = g;
+		}
+	}
+}
+
+// ---------------------- COMPRESS ------------------ //
+
+/**
+	Compresses a column into blocks with block-local sorted dictionaries.
+	With globalIds every local code also gets its id in the global dictionary.
+*/
+template <typename D>
+compressedData<D> compress(const std::vector<D> &column, size_t blockSize = BLOCK_SIZE, bool globalIds = false) {
+	if (blockSize == 0 || blockSize > (size_t(1) << 16)) {
+		throw std::invalid_argument("Block size must be in [1, 2^16]");
+	}
+	compressedData<D> compressed;
+	compressed.blockSize = blockSize;
+	compressed.size = column.size();
+	for (size_t first = 0; first < column.size(); first += blockSize) {
+		auto begin = column.begin() + first;
+		auto end = column.begin() + std::min(first + blockSize, column.size());
+		block<D> b;
+		b.dictionary.assign(begin, end);
+		std::sort(b.dictionary.begin(), b.dictionary.end());
+		b.dictionary.erase(std::unique(b.dictionary.begin(), b.dictionary.end()), b.dictionary.end());
+		b.wide = b.dictionary.size() > (size_t(1) << 8);
+		if (b.wide) {
+			encodeBlock<D, uint16_t>(begin, end, b.dictionary, b.wideCodes);
+		}
+		else {
+			encodeBlock<D, uint8_t>(begin, end, b.dictionary, b.narrowCodes);
+		}
+		compressed.blocks.push_back(std::move(b));
+	}
+	if (globalIds) {
+		buildGlobalIds(compressed);
+	}
+	return compressed;
+}
+
+// ---------------------- DECOMPRESS ------------------ //
+
+/**
+	Decompresses block by block, every gather hits the (small) dictionary of the current block.
+*/
+template <typename D>
+std::vector<D> decompress(const compressedData<D> &compressed) {
+	std::vector<D> decompressed;
+	decompressed.reserve(compressed.size);
+	for (const auto &b : compressed.blocks) {
+		with_codes(b, [&](const auto &codes) {
+			decodeBlock(b.dictionary, codes, decompressed);
+		});
+	}
+	return decompressed;
+}
+
+template <typename D>
+D decompress_at(const compressedData<D> &compressed, size_t i) {
+	const auto &b = compressed.blocks[i / compressed.blockSize];
+	return b.dictionary[b.code(i % compressed.blockSize)];
+}
+
+template <typename D>
+std::vector<D> partial_decompress(const compressedData<D> &compressed, const std::vector<size_t> &indices) {
+	std::vector<D> decompressed;
+	decompressed.reserve(indices.size());
+	for (auto i : indices) {
+		decompressed.push_back(decompress_at(compressed, i));
+	}
+	return decompressed;
+}
+
+/**
+	Global id of every row, e.g. as join or group-by key. Requires compress(..., globalIds = true).
+*/
+template <typename D>
+std::vector<uint32_t> global_ids(const compressedData<D> &compressed) {
+	if (!compressed.size || compressed.blocks[0].globalIds.empty()) {
+		throw std::logic_error("Column was compressed without global ids");
+	}
+	std::vector<uint32_t> ids;
+	ids.reserve(compressed.size);
+	for (const auto &b : compressed.blocks) {
+		with_codes(b, [&](const auto &codes) {
+			for (auto code : codes) {
+				ids.push_back(b.globalIds[code]);
+			}
+		});
+	}
+	return ids;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Evaluates the predicate once per entry of every block dictionary and returns the matching rows.
+*/
+template <typename D>
+std::vector<size_t> where_view(const compressedData<D> &compressed, std::function<bool (D)> predicate) {
+	std::vector<size_t> rows;
+	size_t offset = 0;
+	for (const auto &b : compressed.blocks) {
+		std::vector<uint8_t> matches(b.dictionary.size());
+		for (size_t code = 0; code < b.dictionary.size(); ++code) {
+			matches[code] = predicate(b.dictionary[code]);
+		}
+		with_codes(b, [&](const auto &codes) {
+			for (size_t i = 0; i < codes.size(); ++i) {
+				if (matches[codes[i]]) {
+					rows.push_back(offset + i);
+				}
+			}
+		});
+		offset += b.size();
+	}
+	return rows;
+}
+
+template <typename D>
+size_t count_where_op(const compressedData<D> &compressed, std::function<bool (D)> predicate) {
+	size_t count = 0;
+	for (const auto &b : compressed.blocks) {
+		std::vector<uint8_t> matches(b.dictionary.size());
+		for (size_t code = 0; code < b.dictionary.size(); ++code) {
+			matches[code] = predicate(b.dictionary[code]);
+		}
+		with_codes(b, [&](const auto &codes) {
+			for (auto code : codes) {
+				count += matches[code];
+			}
+		});
+	}
+	return count;
+}
+
+/**
+	GROUP BY value, COUNT(*): per block counts on local codes, added up through the global ids.
+	Index i of the result is the count of globalDictionary[i].
+*/
+template <typename D>
+std::vector<size_t> group_count_op(const compressedData<D> &compressed) {
+	if (!compressed.size || compressed.blocks[0].globalIds.empty()) {
+		throw std::logic_error("Column was compressed without global ids");
+	}
+	std::vector<size_t> counts(compressed.globalDictionary.size(), 0);
+	for (const auto &b : compressed.blocks) {
+		std::vector<size_t> localCounts(b.dictionary.size(), 0);
+		with_codes(b, [&](const auto &codes) {
+			for (auto code : codes) {
+				++localCounts[code];
+			}
+		});
+		for (size_t code = 0; code < localCounts.size(); ++code) {
+			counts[b.globalIds[code]] += localCounts[code];
+		}
+	}
+	return counts;
+}
+
+// ---------------------- BENCHMARK ------------------ //
+
+/**
+	Size of all blocks in bytes, accounted like Dictionary::benchmark_with_dtype.
+*/
+template <typename D>
+size_t compressedSize(const compressedData<D> &compressed) {
+	size_t cSize = sizeof(compressed);
+	for (const auto &b : compressed.blocks) {
+		cSize += sizeof(b);
+		std::vector<D, MyAllocator<D>> dictionaryWithAlloc(b.dictionary.begin(), b.dictionary.end());
+		cSize += dictionaryWithAlloc.get_allocator().allocationInByte();
+		if constexpr (std::is_same_v<D, std::string>) {
+			for (const auto &v : b.dictionary) {
+				cSize += sizeOfString(v);
+			}
+		}
+		cSize += b.narrowCodes.size() * sizeof(uint8_t) + b.wideCodes.size() * sizeof(uint16_t) + b.globalIds.size() * sizeof(uint32_t);
+	}
+	return cSize;
+}
+
+/**
+	Benchmarks block-local Dictionary compression, without global ids.
+*/
+template <typename D>
+Benchmark::CompressionResult benchmark_with_dtype(const std::vector<D> &column, int runs, int warmup, bool clearCache) {
+	auto compressedColumn = compress(column);
+	assert(column == decompress(compressedColumn));
+	std::function<compressedData<D> ()> compressFunction = [&column]() {
+		return compress(column);
+	};
+	std::function<std::vector<D> ()> decompressFunction = [&compressedColumn]() {
+		return decompress(compressedColumn);
+	};
+	std::cout << "Block Local - Compress Benchmark" << std::endl;
+	auto compressRuntimes = Benchmark::benchmark(compressFunction, runs, warmup, clearCache);
+	std::cout << "Block Local - Decompress Benchmark" << std::endl;
+	auto decompressRuntimes = Benchmark::benchmark(decompressFunction, runs, warmup, clearCache);
+
+	size_t cSize = compressedSize(compressedColumn);
+	// Uncompressed Size
+	std::vector<D, MyAllocator<D>> uncompressedWithAlloc(column.begin(), column.end());
+	size_t uSize = uncompressedWithAlloc.get_allocator().allocationInByte();
+	uSize += sizeof(column);
+	if constexpr (std::is_same_v<D, std::string>) {
+		for (const auto &v : column) {
+			uSize += sizeOfString(v);
+		}
+	}
+	return Benchmark::CompressionResult(compressRuntimes, decompressRuntimes, cSize, uSize);
+}
+
+} // end namespace BlockLocal
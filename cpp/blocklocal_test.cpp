@@ -0,0 +1,80 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "blocklocal.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST ROUNDTRIP ####" << std::endl;
+	{
+		std::vector<int> column;
+		for (int i = 0; i < 2500; ++i) {
+			// First blocks have few uniques, the last ones many
+			column.push_back(i < 1000 ? i % 7 : (i * 7919) % 100000);
+		}
+		auto compressedColumn = BlockLocal::compress(column, 1000);
+		assert(compressedColumn.blocks.size() == 3);
+		assert(!compressedColumn.blocks[0].wide && compressedColumn.blocks[0].dictionary.size() == 7);
+		assert(compressedColumn.blocks[1].wide);
+		assert(compressedColumn.blocks[2].size() == 500);
+		assert(column == BlockLocal::decompress(compressedColumn));
+		std::vector<size_t> indices = {2499, 3, 1000, 999};
+		std::vector<int> expectedPartial = {column[2499], column[3], column[1000], column[999]};
+		assert(BlockLocal::partial_decompress(compressedColumn, indices) == expectedPartial);
+
+		bool thrown = false;
+		try {
+			BlockLocal::compress(column, (1 << 16) + 1);
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::cout << "#### TEST GLOBAL IDS ####" << std::endl;
+	{
+		std::vector<std::string> column = {"b", "a", "b", "d", "c", "a", "e", "d"};
+		auto compressedColumn = BlockLocal::compress(column, 3, true);
+		std::vector<std::string> expectedGlobal = {"a", "b", "c", "d", "e"};
+		assert(compressedColumn.globalDictionary == expectedGlobal);
+		std::vector<uint32_t> expectedIds = {1, 0, 1, 3, 2, 0, 4, 3};
+		assert(BlockLocal::global_ids(compressedColumn) == expectedIds);
+		std::vector<size_t> expectedCounts = {2, 2, 1, 2, 1};
+		assert(BlockLocal::group_count_op(compressedColumn) == expectedCounts);
+
+		bool thrown = false;
+		try {
+			BlockLocal::global_ids(BlockLocal::compress(column, 3));
+		}
+		catch (const std::logic_error &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::cout << "#### TEST OPS ####" << std::endl;
+	{
+		std::vector<int> column;
+		for (int i = 0; i < 5000; ++i) {
+			column.push_back((i * 37) % 1000);
+		}
+		auto compressedColumn = BlockLocal::compress(column, 512);
+		std::function<bool(int)> predicate = [](int v) { return v < 100; };
+		std::vector<size_t> expectedView;
+		for (size_t i = 0; i < column.size(); ++i) {
+			if (predicate(column[i])) {
+				expectedView.push_back(i);
+			}
+		}
+		assert(BlockLocal::where_view(compressedColumn, predicate) == expectedView);
+		assert(BlockLocal::count_where_op(compressedColumn, predicate) == expectedView.size());
+	}
+	return 0;
+}
@@ -0,0 +1,323 @@
+#include <limits>
+#include <list>
+#include <optional>
+#include <sstream>
+#include <variant>
+
+namespace Cache
+{
+
+/**
+	Memory budget of a cache in bytes: results and their keys, without the bookkeeping of the containers.
+*/
+const size_t DEFAULT_BUDGET = size_t(64) << 20;
+
+enum class Op {
+	Equal,
+	In,
+	Range
+};
+
+/**
+	Predicate in normal form, so that equivalent filters share one cache entry:
+		- Equal: values holds the value
+		- In: values sorted without duplicates, a list of one value becomes Equal
+		- Range: [from, to), a missing bound is open
+*/
+template <typename D>
+struct predicate {
+	Op op = Op::Equal;
+	std::vector<D> values;
+	std::optional<D> from;
+	std::optional<D> to;
+
+	bool match(const D &value) const {
+		switch (op) {
+		case Op::Equal:
+			return value == values[0];
+		case Op::In:
+			return std::binary_search(values.begin(), values.end(), value);
+		default:
+			return (!from || !(value < *from)) && (!to || value < *to);
+		}
+	}
+};
+
+/**
+	Cached result: a selection bitmap (one bit per row) or an aggregate.
+*/
+using result = std::variant<std::vector<uint64_t>, double>;
+
+struct statistics {
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+	size_t invalidations = 0;
+	size_t entries = 0;
+	size_t bytes = 0;
+
+	double hitRate() const { return hits + misses == 0 ? 0 : (double)hits / (hits + misses); }
+};
+
+// ---------------------- PREDICATES ------------------ //
+
+template <typename D>
+predicate<D> equal(const D &value) {
+	predicate<D> result;
+	result.op = Op::Equal;
+	result.values = {value};
+	return result;
+}
+
+template <typename D>
+predicate<D> in(std::vector<D> values) {
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+	if (values.size() == 1) {
+		return equal(values[0]);
+	}
+	predicate<D> result;
+	result.op = Op::In;
+	result.values = std::move(values);
+	return result;
+}
+
+template <typename D>
+predicate<D> range(std::optional<D> from, std::optional<D> to) {
+	predicate<D> result;
+	result.op = Op::Range;
+	result.from = from;
+	result.to = to;
+	return result;
+}
+
+/**
+	Canonical text of a predicate. Values are length prefixed, so no value can be mistaken for a separator.
+	Floating point values are written with max_digits10 digits, so distinct values never share a key.
+*/
+template <typename D>
+std::string key(const predicate<D> &p) {
+	auto write = [](std::ostringstream &out, const D &value) {
+		std::ostringstream text;
+		if constexpr (std::is_floating_point_v<D>) {
+			text.precision(std::numeric_limits<D>::max_digits10);
+		}
+		text << value;
+		out << text.str().size() << ':' << text.str();
+	};
+	std::ostringstream out;
+	if (p.op == Op::Range) {
+		out << "range(";
+		p.from ? write(out, *p.from) : (void)(out << '-');
+		out << ',';
+		p.to ? write(out, *p.to) : (void)(out << '-');
+	}
+	else {
+		out << (p.op == Op::Equal ? "eq(" : "in(");
+		for (const auto &value : p.values) {
+			write(out, value);
+		}
+	}
+	out << ')';
+	return out.str();
+}
+
+// ---------------------- CACHE ------------------ //
+
+/**
+	LRU cache of predicate results. Entries are keyed by the columns they were computed from, their versions
+	and the normalized predicate. invalidate() is called whenever a column is re-encoded or appended to:
+	it bumps the version of the column and drops every entry computed from it.
+*/
+class ResultCache
+{
+public:
+	ResultCache(size_t budget = DEFAULT_BUDGET) : budget(budget) { }
+
+	size_t version(const std::string &column) const {
+		auto it = versions.find(column);
+		return it == versions.end() ? 0 : it->second;
+	}
+
+	/**
+		Key of a result computed from the given columns: every column with its current version, then the operation.
+	*/
+	std::string key(const std::vector<std::string> &columns, const std::string &operation) const {
+		std::ostringstream out;
+		for (const auto &column : columns) {
+			out << column.size() << ':' << column << '@' << version(column) << '/';
+		}
+		out << operation;
+		return out.str();
+	}
+
+	/**
+		The cached result, most recently used from now on, or nullptr. The pointer is valid until the next insert() or invalidate().
+	*/
+	const result *find(const std::string &key) {
+		auto it = index.find(key);
+		if (it == index.end()) {
+			++stats.misses;
+			return nullptr;
+		}
+		++stats.hits;
+		entries.splice(entries.begin(), entries, it->second);
+		return &it->second->value;
+	}
+
+	/**
+		Stores a result, evicting the least recently used entries until it fits. Results larger than the budget are not cached.
+	*/
+	void insert(const std::string &key, const std::vector<std::string> &columns, result value) {
+		erase(key);
+		size_t bytes = key.size() + std::visit([](const auto &v) { return sizeOf(v); }, value);
+		if (bytes > budget) {
+			return;
+		}
+		while (stats.bytes + bytes > budget) {
+			remove(std::prev(entries.end()));
+			++stats.evictions;
+		}
+		entries.push_front(entry{key, columns, std::move(value), bytes});
+		index[key] = entries.begin();
+		stats.bytes += bytes;
+		++stats.entries;
+	}
+
+	void invalidate(const std::string &column) {
+		++versions[column];
+		++stats.invalidations;
+		for (auto it = entries.begin(); it != entries.end();) {
+			auto current = it++;
+			if (std::find(current->columns.begin(), current->columns.end(), column) != current->columns.end()) {
+				remove(current);
+			}
+		}
+	}
+
+	void clear() {
+		entries.clear();
+		index.clear();
+		stats.entries = 0;
+		stats.bytes = 0;
+	}
+
+	const statistics &getStatistics() const { return stats; }
+
+private:
+	struct entry {
+		std::string key;
+		std::vector<std::string> columns;
+		result value;
+		size_t bytes;
+	};
+
+	static size_t sizeOf(const std::vector<uint64_t> &bitmap) { return bitmap.size() * sizeof(uint64_t); }
+	static size_t sizeOf(double) { return sizeof(double); }
+
+	void erase(const std::string &key) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			remove(it->second);
+		}
+	}
+
+	void remove(std::list<entry>::iterator it) {
+		stats.bytes -= it->bytes;
+		--stats.entries;
+		index.erase(it->key);
+		entries.erase(it);
+	}
+
+	size_t budget;
+	std::list<entry> entries;
+	std::unordered_map<std::string, std::list<entry>::iterator> index;
+	std::unordered_map<std::string, size_t> versions;
+	statistics stats;
+};
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Selection bitmap of a Dictionary compressed column, the predicate is evaluated once per dictionary entry.
+*/
+template <typename D, typename C>
+std::vector<uint64_t> select(const std::pair<std::vector<D>, std::vector<C>> &compressed, const predicate<D> &p) {
+	std::vector<uint8_t> matches(compressed.first.size());
+	for (size_t code = 0; code < matches.size(); ++code) {
+		matches[code] = p.match(compressed.first[code]);
+	}
+	std::vector<uint64_t> bitmap((compressed.second.size() + 63) / 64, 0);
+	for (size_t row = 0; row < compressed.second.size(); ++row) {
+		bitmap[row / 64] |= uint64_t(matches[compressed.second[row]]) << (row % 64);
+	}
+	return bitmap;
+}
+
+inline size_t count(const std::vector<uint64_t> &bitmap) {
+	size_t result = 0;
+	for (auto word : bitmap) {
+		result += __builtin_popcountll(word);
+	}
+	return result;
+}
+
+inline std::vector<size_t> rows(const std::vector<uint64_t> &bitmap) {
+	std::vector<size_t> result;
+	for (size_t w = 0; w < bitmap.size(); ++w) {
+		for (uint64_t word = bitmap[w]; word != 0; word &= word - 1) {
+			result.push_back(w * 64 + __builtin_ctzll(word));
+		}
+	}
+	return result;
+}
+
+/**
+	Selection bitmap of column WHERE p, from the cache if the column did not change since it was computed.
+*/
+template <typename D, typename C>
+std::vector<uint64_t> where(ResultCache &cache, const std::string &column, const std::pair<std::vector<D>, std::vector<C>> &compressed,
+                            const predicate<D> &p) {
+	auto k = cache.key({column}, "where " + key(p));
+	if (const auto *cached = cache.find(k)) {
+		return std::get<std::vector<uint64_t>>(*cached);
+	}
+	auto bitmap = select(compressed, p);
+	cache.insert(k, {column}, bitmap);
+	return bitmap;
+}
+
+/**
+	COUNT(*) WHERE p. A miss reuses (or caches) the selection bitmap of the predicate.
+*/
+template <typename D, typename C>
+size_t count_where(ResultCache &cache, const std::string &column, const std::pair<std::vector<D>, std::vector<C>> &compressed,
+                   const predicate<D> &p) {
+	auto k = cache.key({column}, "count " + key(p));
+	if (const auto *cached = cache.find(k)) {
+		return std::get<double>(*cached);
+	}
+	size_t result = count(where(cache, column, compressed, p));
+	cache.insert(k, {column}, (double)result);
+	return result;
+}
+
+/**
+	SUM(valueColumn) WHERE p(filterColumn), invalidated by a change of either column.
+*/
+template <typename D, typename C, typename V, typename W>
+double sum_where(ResultCache &cache, const std::string &filterColumn, const std::pair<std::vector<D>, std::vector<C>> &filter,
+                 const predicate<D> &p, const std::string &valueColumn, const std::pair<std::vector<V>, std::vector<W>> &values) {
+	auto k = cache.key({filterColumn, valueColumn}, "sum " + key(p));
+	if (const auto *cached = cache.find(k)) {
+		return std::get<double>(*cached);
+	}
+	double result = 0;
+	for (auto row : rows(where(cache, filterColumn, filter, p))) {
+		result += values.first[values.second[row]];
+	}
+	cache.insert(k, {filterColumn, valueColumn}, result);
+	return result;
+}
+
+} // end namespace Cache
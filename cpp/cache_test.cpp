@@ -0,0 +1,108 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "date.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "cache.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST PREDICATES ####" << std::endl;
+	{
+		assert(Cache::key(Cache::in<std::string>({"P", "O", "P"})) == Cache::key(Cache::in<std::string>({"O", "P"})));
+		assert(Cache::key(Cache::in<std::string>({"O", "O"})) == Cache::key(Cache::equal<std::string>("O")));
+		assert(Cache::key(Cache::in<std::string>({"a,b"})) != Cache::key(Cache::in<std::string>({"a", "b"})));
+		assert(Cache::key(Cache::range<int>(1, {})) != Cache::key(Cache::range<int>({}, 1)));
+		auto date = Date::parse<uint16_t>("1996-01-02");
+		assert(Cache::key(Cache::range<Date::date16>({}, date)) == "range(-,10:1996-01-02)");
+		assert(Cache::key(Cache::range<float>({}, 123456.2f)) != Cache::key(Cache::range<float>({}, 123456.4f)));
+		assert(Cache::key(Cache::equal<double>(0.1)) != Cache::key(Cache::equal<double>(0.1 + 1e-12)));
+
+		// Ranges close together on a float column get their own entries and results
+		auto compressed = Dictionary::compress<float, uint8_t>({123456.3f});
+		Cache::ResultCache cache;
+		assert(Cache::count_where(cache, "PRICE", compressed, Cache::range<float>({}, 123456.2f)) == 0);
+		assert(Cache::count_where(cache, "PRICE", compressed, Cache::range<float>({}, 123456.4f)) == 1);
+	}
+	std::cout << "#### TEST HITS AND INVALIDATION ####" << std::endl;
+	{
+		std::vector<std::string> status;
+		std::vector<int> price;
+		for (int i = 0; i < 1000; ++i) {
+			status.push_back(i % 3 == 0 ? "O" : (i % 3 == 1 ? "F" : "P"));
+			price.push_back(i);
+		}
+		auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+		auto compressedPrice = Dictionary::compress<int, uint16_t>(price);
+		Cache::ResultCache cache;
+		auto isOpen = Cache::equal<std::string>("O");
+
+		auto bitmap = Cache::where(cache, "ORDERSTATUS", compressedStatus, isOpen);
+		assert(Cache::count(bitmap) == 334);
+		assert(Cache::rows(bitmap)[1] == 3);
+		assert(cache.getStatistics().misses == 1 && cache.getStatistics().hits == 0);
+		assert(Cache::where(cache, "ORDERSTATUS", compressedStatus, Cache::in<std::string>({"O"})) == bitmap);
+		assert(cache.getStatistics().hits == 1);
+
+		// The count misses once and reuses the cached bitmap
+		assert(Cache::count_where(cache, "ORDERSTATUS", compressedStatus, isOpen) == 334);
+		assert(Cache::count_where(cache, "ORDERSTATUS", compressedStatus, isOpen) == 334);
+		assert(cache.getStatistics().hits == 3 && cache.getStatistics().misses == 2);
+		double expected = 0;
+		for (int i = 0; i < 1000; i += 3) {
+			expected += i;
+		}
+		assert(Cache::sum_where(cache, "ORDERSTATUS", compressedStatus, isOpen, "TOTALPRICE", compressedPrice) == expected);
+		assert(cache.getStatistics().entries == 3);
+
+		// Appending to a column invalidates everything computed from it
+		price.push_back(999);
+		compressedPrice = Dictionary::compress<int, uint16_t>(price);
+		cache.invalidate("TOTALPRICE");
+		assert(cache.version("TOTALPRICE") == 1);
+		assert(cache.getStatistics().entries == 2);
+		status.push_back("O");
+		compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+		cache.invalidate("ORDERSTATUS");
+		assert(cache.getStatistics().entries == 0 && cache.getStatistics().bytes == 0);
+		size_t misses = cache.getStatistics().misses;
+		assert(Cache::count_where(cache, "ORDERSTATUS", compressedStatus, isOpen) == 335);
+		assert(Cache::sum_where(cache, "ORDERSTATUS", compressedStatus, isOpen, "TOTALPRICE", compressedPrice) == expected + 999);
+		assert(cache.getStatistics().misses == misses + 3);
+	}
+	std::cout << "#### TEST EVICTION ####" << std::endl;
+	{
+		std::vector<int> column(64 * 100);
+		for (size_t i = 0; i < column.size(); ++i) {
+			column[i] = i % 100;
+		}
+		auto compressedColumn = Dictionary::compress<int, uint8_t>(column);
+		// Room for two bitmaps of 800 bytes and their keys, not for three
+		Cache::ResultCache cache(2000);
+		Cache::where(cache, "A", compressedColumn, Cache::equal(1));
+		Cache::where(cache, "A", compressedColumn, Cache::equal(2));
+		Cache::where(cache, "A", compressedColumn, Cache::equal(1));
+		Cache::where(cache, "A", compressedColumn, Cache::equal(3));
+		const auto &stats = cache.getStatistics();
+		assert(stats.entries == 2 && stats.evictions == 1 && stats.bytes <= 2000);
+		// 2 was least recently used
+		size_t hits = stats.hits;
+		Cache::where(cache, "A", compressedColumn, Cache::equal(1));
+		assert(stats.hits == hits + 1);
+		Cache::where(cache, "A", compressedColumn, Cache::equal(2));
+		assert(stats.hits == hits + 1);
+
+		Cache::ResultCache tiny(100);
+		Cache::where(tiny, "A", compressedColumn, Cache::equal(1));
+		assert(tiny.getStatistics().entries == 0);
+	}
+	return 0;
+}
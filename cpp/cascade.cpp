@@ -0,0 +1,362 @@
+#include <type_traits>
+
+namespace Cascade
+{
+
+/**
+	Fixed-width bit packing: value i occupies bits [i * width, (i + 1) * width).
+*/
+struct bitPacked {
+	std::vector<uint64_t> words;
+	uint8_t width = 0;
+	size_t size = 0;
+
+	uint64_t get(size_t i) const {
+		if (width == 0) {
+			return 0;
+		}
+		size_t bit = i * width;
+		size_t word = bit / 64;
+		size_t offset = bit % 64;
+		uint64_t value = words[word] >> offset;
+		if (offset + width > 64) {
+			value |= words[word + 1] << (64 - offset);
+		}
+		return width == 64 ? value : value & ((uint64_t(1) << width) - 1);
+	}
+};
+
+/**
+	Run-length encoding: run i has value values[i] and ends (exclusive) at ends[i].
+*/
+template <typename C>
+struct runLength {
+	std::vector<C> values;
+	std::vector<size_t> ends;
+};
+
+/**
+	A Dictionary compressed column with a second lightweight codec on each part:
+		- Integral dictionaries are stored as frame of reference (base + bit-packed offsets)
+		- The attribute vector is stored run-length encoded or bit-packed, whichever is smaller
+*/
+template <typename D, typename C>
+struct compressedData {
+	bool dictionaryPacked = false;
+	std::vector<D> dictionary;
+	D base{};
+	bitPacked packedDictionary;
+
+	bool runLengthEncoded = false;
+	runLength<C> runs;
+	bitPacked codes;
+
+	size_t size = 0;
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+uint8_t bitWidth(uint64_t maxValue) {
+	uint8_t width = 0;
+	while (width < 64 && (maxValue >> width) != 0) {
+		++width;
+	}
+	return width;
+}
+
+template <typename T>
+bitPacked pack(const std::vector<T> &values, uint8_t width) {
+	bitPacked packed;
+	packed.width = width;
+	packed.size = values.size();
+	packed.words.assign((values.size() * width + 63) / 64 + 1, 0);
+	for (size_t i = 0; i < values.size() && width > 0; ++i) {
+		uint64_t value = (uint64_t)values[i];
+		size_t bit = i * width;
+		size_t word = bit / 64;
+		size_t offset = bit % 64;
+		packed.words[word] |= value << offset;
+		if (offset + width > 64) {
+			packed.words[word + 1] |= value >> (64 - offset);
+		}
+	}
+	return packed;
+}
+
+template <typename C>
+runLength<C> runLengthEncode(const std::vector<C> &values) {
+	runLength<C> runs;
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (runs.values.empty() || runs.values.back() != values[i]) {
+			runs.values.push_back(values[i]);
+			runs.ends.push_back(i + 1);
+		}
+		else {
+			runs.ends.back() = i + 1;
+		}
+	}
+	return runs;
+}
+
+/**
+	Returns the dictionary value for a code without unpacking the dictionary.
+*/
+template <typename D, typename C>
+D dictionary_at(const compressedData<D, C> &compressed, size_t code) {
+	if constexpr (std::is_integral_v<D>) {
+		if (compressed.dictionaryPacked) {
+			return (D)((uint64_t)compressed.base + compressed.packedDictionary.get(code));
+		}
+	}
+	return compressed.dictionary[code];
+}
+
+template <typename D, typename C>
+size_t dictionary_size(const compressedData<D, C> &compressed) {
+	return compressed.dictionaryPacked ? compressed.packedDictionary.size : compressed.dictionary.size();
+}
+
+/**
+	Returns the code of row i. O(1) for bit-packed, O(log runs) for run-length encoded attribute vectors.
+*/
+template <typename D, typename C>
+C code_at(const compressedData<D, C> &compressed, size_t i) {
+	if (compressed.runLengthEncoded) {
+		auto run = std::upper_bound(compressed.runs.ends.begin(), compressed.runs.ends.end(), i) - compressed.runs.ends.begin();
+		return compressed.runs.values[run];
+	}
+	return (C)compressed.codes.get(i);
+}
+
+/**
+	Calls fn(code, first, count) for every run of equal codes (run-length encoded) or
+	for every single row (bit-packed). The attribute vector is never materialized.
+*/
+template <typename D, typename C, typename F>
+void for_each_code(const compressedData<D, C> &compressed, F fn) {
+	if (compressed.runLengthEncoded) {
+		size_t begin = 0;
+		for (size_t run = 0; run < compressed.runs.values.size(); ++run) {
+			fn(compressed.runs.values[run], begin, compressed.runs.ends[run] - begin);
+			begin = compressed.runs.ends[run];
+		}
+	}
+	else {
+		for (size_t i = 0; i < compressed.size; ++i) {
+			fn((C)compressed.codes.get(i), i, (size_t)1);
+		}
+	}
+}
+
+/**
+	Evaluates the predicate once per dictionary entry.
+*/
+template <typename D, typename C>
+std::vector<bool> dictionary_matches(const compressedData<D, C> &compressed, std::function<bool (D)> predicate) {
+	std::vector<bool> matches(dictionary_size(compressed));
+	for (size_t code = 0; code < matches.size(); ++code) {
+		matches[code] = predicate(dictionary_at(compressed, code));
+	}
+	return matches;
+}
+
+// ---------------------- COMPRESS ------------------ //
+
+/**
+	Applies the second stage to a Dictionary compressed column (see Dictionary::compress).
+*/
+template <typename D, typename C>
+compressedData<D, C> compress(const std::pair<std::vector<D>, std::vector<C>> &dictionaryCompressed) {
+	compressedData<D, C> compressed;
+	compressed.size = dictionaryCompressed.second.size();
+
+	// Dictionary: frame of reference. The dictionary is sorted, so the first value is the minimum.
+	compressed.dictionary = dictionaryCompressed.first;
+	if constexpr (std::is_integral_v<D>) {
+		if (!dictionaryCompressed.first.empty()) {
+			compressed.base = dictionaryCompressed.first.front();
+			std::vector<uint64_t> offsets;
+			offsets.reserve(dictionaryCompressed.first.size());
+			for (auto value : dictionaryCompressed.first) {
+				offsets.push_back((uint64_t)value - (uint64_t)compressed.base);
+			}
+			auto packed = pack(offsets, bitWidth(offsets.back()));
+			if (packed.words.size() * sizeof(uint64_t) < dictionaryCompressed.first.size() * sizeof(D)) {
+				compressed.packedDictionary = packed;
+				compressed.dictionaryPacked = true;
+				compressed.dictionary.clear();
+				compressed.dictionary.shrink_to_fit();
+			}
+		}
+	}
+
+	// Attribute vector: run-length encoding or bit packing, whichever is smaller
+	auto width = bitWidth(dictionaryCompressed.first.empty() ? 0 : dictionaryCompressed.first.size() - 1);
+	size_t packedBytes = ((compressed.size * width + 63) / 64 + 1) * sizeof(uint64_t);
+	auto runs = runLengthEncode(dictionaryCompressed.second);
+	size_t runLengthBytes = runs.values.size() * (sizeof(C) + sizeof(size_t));
+	if (runLengthBytes < packedBytes) {
+		compressed.runs = runs;
+		compressed.runLengthEncoded = true;
+	}
+	else {
+		compressed.codes = pack(dictionaryCompressed.second, width);
+	}
+	return compressed;
+}
+
+/**
+	Decompresses a column.
+*/
+template <typename D, typename C>
+std::vector<D> decompress(const compressedData<D, C> &compressed) {
+	std::vector<D> decompressed;
+	decompressed.reserve(compressed.size);
+	for_each_code(compressed, [&compressed, &decompressed](C code, size_t, size_t count) {
+		auto value = dictionary_at(compressed, code);
+		decompressed.insert(decompressed.end(), count, value);
+	});
+	return decompressed;
+}
+
+/**
+	Partially decompresses a column. Only the rows in `indices`.
+*/
+template <typename D, typename C>
+std::vector<D> partial_decompress(const compressedData<D, C> &compressed, const std::vector<size_t> &indices) {
+	std::vector<D> decompressed;
+	decompressed.reserve(indices.size());
+	for (auto index : indices) {
+		decompressed.push_back(dictionary_at(compressed, code_at(compressed, index)));
+	}
+	return decompressed;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Returns indices of all values matching the predicate.
+	1. Evaluate the predicate on the (packed) dictionary.
+	2. Walk the runs / packed codes and emit matching positions.
+*/
+template <typename D, typename C>
+std::vector<size_t> where_view(const compressedData<D, C> &compressed, std::function<bool (D)> predicate) {
+	auto matches = dictionary_matches(compressed, predicate);
+	std::vector<size_t> view;
+	for_each_code(compressed, [&matches, &view](C code, size_t first, size_t count) {
+		if (matches[code]) {
+			for (size_t i = first; i < first + count; ++i) {
+				view.push_back(i);
+			}
+		}
+	});
+	return view;
+}
+
+/**
+	Counts all values matching the predicate. Run-length encoded columns add whole runs at once.
+*/
+template <typename D, typename C>
+size_t count_where_op(const compressedData<D, C> &compressed, std::function<bool (D)> predicate) {
+	auto matches = dictionary_matches(compressed, predicate);
+	size_t total = 0;
+	for_each_code(compressed, [&matches, &total](C code, size_t, size_t count) {
+		if (matches[code]) {
+			total += count;
+		}
+	});
+	return total;
+}
+
+template <typename D, typename C>
+D min_op(const compressedData<D, C> &compressed) {
+	return dictionary_at(compressed, 0);
+}
+
+template <typename D, typename C>
+D max_op(const compressedData<D, C> &compressed) {
+	return dictionary_at(compressed, dictionary_size(compressed) - 1);
+}
+
+/**
+	Calculates the sum of all values in a column.
+	Counts occurrences per code first, so every dictionary value is unpacked once.
+*/
+template <typename D, typename C>
+size_t sum_op(const compressedData<D, C> &compressed) {
+	std::vector<size_t> counts(dictionary_size(compressed), 0);
+	for_each_code(compressed, [&counts](C code, size_t, size_t count) {
+		counts[code] += count;
+	});
+	size_t total_sum = 0;
+	for (size_t code = 0; code < counts.size(); ++code) {
+		if (counts[code] > 0) {
+			total_sum += dictionary_at(compressed, code) * counts[code];
+		}
+	}
+	return total_sum;
+}
+
+template <typename D, typename C>
+float avg_op(const compressedData<D, C> &compressed) {
+	return (float)sum_op(compressed) / (float)compressed.size;
+}
+
+// ---------------------- BENCHMARK ------------------ //
+
+/**
+	Size of the cascaded column in bytes, accounted like Dictionary::benchmark_with_dtype.
+*/
+template <typename D, typename C>
+size_t compressedSize(const compressedData<D, C> &compressed) {
+	size_t cSize = sizeof(compressed);
+	std::vector<D, MyAllocator<D>> dictionaryWithAlloc(compressed.dictionary.begin(), compressed.dictionary.end());
+	cSize += dictionaryWithAlloc.get_allocator().allocationInByte();
+	if constexpr (std::is_same_v<D, std::string>) {
+		for (const auto &v : compressed.dictionary) {
+			cSize += sizeOfString(v);
+		}
+	}
+	std::vector<uint64_t, MyAllocator<uint64_t>> packedDictionaryWithAlloc(compressed.packedDictionary.words.begin(), compressed.packedDictionary.words.end());
+	cSize += packedDictionaryWithAlloc.get_allocator().allocationInByte();
+	std::vector<C, MyAllocator<C>> runValuesWithAlloc(compressed.runs.values.begin(), compressed.runs.values.end());
+	cSize += runValuesWithAlloc.get_allocator().allocationInByte();
+	std::vector<size_t, MyAllocator<size_t>> runEndsWithAlloc(compressed.runs.ends.begin(), compressed.runs.ends.end());
+	cSize += runEndsWithAlloc.get_allocator().allocationInByte();
+	std::vector<uint64_t, MyAllocator<uint64_t>> codesWithAlloc(compressed.codes.words.begin(), compressed.codes.words.end());
+	cSize += codesWithAlloc.get_allocator().allocationInByte();
+	return cSize;
+}
+
+/**
+	Benchmarks Dictionary compression followed by the cascading stage.
+*/
+template <typename D, typename C>
+Benchmark::CompressionResult benchmark_with_dtype(const std::vector<D> &column, int runs, int warmup, bool clearCache) {
+	auto compressedColumn = compress(Dictionary::compress<D, C>(column));
+	assert(column == decompress(compressedColumn));
+	std::function<compressedData<D, C> ()> compressFunction = [&column]() {
+		return compress(Dictionary::compress<D, C>(column));
+	};
+	std::function<std::vector<D> ()> decompressFunction = [&compressedColumn]() {
+		return decompress(compressedColumn);
+	};
+	std::cout << "Cascade - Compress Benchmark" << std::endl;
+	auto compressRuntimes = Benchmark::benchmark(compressFunction, runs, warmup, clearCache);
+	std::cout << "Cascade - Decompress Benchmark" << std::endl;
+	auto decompressRuntimes = Benchmark::benchmark(decompressFunction, runs, warmup, clearCache);
+
+	size_t cSize = compressedSize(compressedColumn);
+	// Uncompressed Size
+	std::vector<D, MyAllocator<D>> uncompressedWithAlloc(column.begin(), column.end());
+	size_t uSize = uncompressedWithAlloc.get_allocator().allocationInByte();
+	uSize += sizeof(column);
+	if constexpr (std::is_same_v<D, std::string>) {
+		for (const auto &v : column) {
+			uSize += sizeOfString(v);
+		}
+	}
+	return Benchmark::CompressionResult(compressRuntimes, decompressRuntimes, cSize, uSize);
+}
+
+} // end namespace Cascade
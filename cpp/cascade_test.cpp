@@ -0,0 +1,99 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "cascade.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST BIT PACKING ####" << std::endl;
+	{
+		std::vector<uint64_t> values = {0, 1, 2, 3, 4, 5, 6, 7, 1000, 123456789};
+		for (uint8_t width : {27, 33, 64}) {
+			auto packed = Cascade::pack(values, width);
+			for (size_t i = 0; i < values.size(); ++i) {
+				assert(packed.get(i) == values[i]);
+			}
+		}
+		assert(Cascade::bitWidth(0) == 0);
+		assert(Cascade::bitWidth(1) == 1);
+		assert(Cascade::bitWidth(255) == 8);
+		assert(Cascade::bitWidth(256) == 9);
+	}
+	std::cout << "#### TEST WITH INT (RLE) ####" << std::endl;
+	{
+		std::vector<int> column;
+		for (int i = 0; i < 1000; ++i) {
+			column.push_back(100000 + (i / 100) * 7);
+		}
+		auto compressedColumn = Cascade::compress(Dictionary::compress<int, uint16_t>(column));
+		assert(compressedColumn.runLengthEncoded);
+		assert(compressedColumn.dictionaryPacked);
+		assert(compressedColumn.runs.values.size() == 10);
+		assert(column == Cascade::decompress(compressedColumn));
+
+		std::vector<size_t> indices = {0, 150, 999};
+		std::vector<int> expectedPartial = {100000, 100007, 100063};
+		assert(Cascade::partial_decompress(compressedColumn, indices) == expectedPartial);
+
+		std::function<bool (int)> predicate = [](int i) {
+			return i >= 100056;
+		};
+		assert(Cascade::count_where_op(compressedColumn, predicate) == 200);
+		assert(Cascade::where_view(compressedColumn, predicate).front() == 800);
+		assert(Cascade::min_op(compressedColumn) == 100000);
+		assert(Cascade::max_op(compressedColumn) == 100063);
+		assert(Cascade::sum_op(compressedColumn) == 100031500);
+	}
+	std::cout << "#### TEST WITH INT (BIT PACKING) ####" << std::endl;
+	{
+		std::vector<int> column = {1, 2, 3, 4, 5, 6, 7, 8, 9, 1};
+		auto dictionaryCompressed = Dictionary::compress<int, uint8_t>(column);
+		auto compressedColumn = Cascade::compress(dictionaryCompressed);
+		assert(!compressedColumn.runLengthEncoded);
+		assert(compressedColumn.codes.width == 4);
+		assert(column == Cascade::decompress(compressedColumn));
+		assert(Cascade::sum_op(compressedColumn) == Dictionary::sum_op(dictionaryCompressed));
+		assert(Cascade::avg_op(compressedColumn) == 4.6f);
+		std::function<bool (int)> predicate = [](int i) {
+			return i > 5;
+		};
+		std::vector<size_t> expectedView = {5, 6, 7, 8};
+		assert(Cascade::where_view(compressedColumn, predicate) == expectedView);
+	}
+	std::cout << "#### TEST WITH INT64 (WIDE RANGE) ####" << std::endl;
+	{
+		// Values across most of the int64_t range, offsets from the minimum take 63 bits
+		std::vector<int64_t> column;
+		for (int64_t i = 0; i < 128; ++i) {
+			column.push_back(i * (int64_t(1) << 56) - (int64_t(1) << 62));
+		}
+		auto dictionaryCompressed = Dictionary::compress<int64_t, uint8_t>(column);
+		auto compressedColumn = Cascade::compress(dictionaryCompressed);
+		assert(compressedColumn.dictionaryPacked);
+		assert(Cascade::dictionary_at(compressedColumn, 0) == column.front());
+		assert(Cascade::dictionary_at(compressedColumn, 127) == column.back());
+		assert(column == Cascade::decompress(compressedColumn));
+	}
+	std::cout << "#### TEST WITH STD::STRING ####" << std::endl;
+	{
+		std::vector<std::string> column = {"O", "O", "O", "F", "F", "P", "O", "O"};
+		auto compressedColumn = Cascade::compress(Dictionary::compress<std::string, uint8_t>(column));
+		assert(!compressedColumn.dictionaryPacked);
+		assert(column == Cascade::decompress(compressedColumn));
+		std::function<bool (std::string)> predicate = [](std::string s) {
+			return s == "O";
+		};
+		assert(Cascade::count_where_op(compressedColumn, predicate) == 5);
+		assert(Cascade::min_op(compressedColumn) == "F");
+	}
+	return 0;
+}
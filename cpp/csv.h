@@ -5,12 +5,45 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <string_view>
 
 namespace CSV {
 std::vector<std::string> headerFromFile(std::string filePath);
 
 std::vector<std::vector<std::string>> toColumnStore(std::string filePath, bool skipHeader = true);
 
+/**
+	A read-only memory mapping of a whole file.
+*/
+class MappedFile
+{
+public:
+	MappedFile(std::string filePath);
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	~MappedFile();
+
+	const char *data() const { return begin; }
+	size_t size() const { return length; }
+
+private:
+	const char *begin = nullptr;
+	size_t length = 0;
+};
+
+/**
+	Splits the mapped file into one chunk per thread at line boundaries and parses the chunks in parallel.
+	Only the requested columns are collected, all others stay empty. The views point into the mapping.
+*/
+std::vector<std::vector<std::string_view>> toColumnViews(const MappedFile &file, const std::vector<size_t> &columns,
+        size_t threads = 0, bool skipHeader = true);
+
+/**
+	Same as toColumnViews() but every thread copies its cells into std::strings, so the result outlives the mapping.
+*/
+std::vector<std::vector<std::string>> toColumnStoreParallel(std::string filePath, const std::vector<size_t> &columns,
+        size_t threads = 0, bool skipHeader = true);
+
 std::vector<std::vector<std::string>> toRowStore(std::string filePath, bool skipHeader = true);
 
 template <typename T>
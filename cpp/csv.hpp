@@ -1,4 +1,12 @@
 #include <algorithm>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
 std::vector<std::string> CSV::headerFromFile(std::string filePath) {
@@ -52,6 +60,177 @@ std::vector<std::vector<std::string>> CSV::toColumnStore(std::string filePath, b
 	return table;
 }
 
+CSV::MappedFile::MappedFile(std::string filePath) {
+	int fd = ::open(filePath.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Cannot open " + filePath);
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		throw std::runtime_error("Cannot stat " + filePath);
+	}
+	length = info.st_size;
+	if (length > 0) {
+		void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			::close(fd);
+			throw std::runtime_error("Cannot map " + filePath);
+		}
+		madvise(mapping, length, MADV_SEQUENTIAL);
+		begin = static_cast<const char *>(mapping);
+	}
+	::close(fd);
+}
+
+CSV::MappedFile::~MappedFile() {
+	if (begin != nullptr) {
+		munmap(const_cast<char *>(begin), length);
+	}
+}
+
+namespace CSV {
+/**
+	Returns the first cell or row separator in [it, end) or end. Compares 16 bytes at a time with SSE2.
+*/
+inline const char *findSeparator(const char *it, const char *end, char cellSeparator, char rowSeparator) {
+#if defined(__SSE2__)
+	const __m128i cells = _mm_set1_epi8(cellSeparator);
+	const __m128i rows = _mm_set1_epi8(rowSeparator);
+	for (; it + 16 <= end; it += 16) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+		int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, cells), _mm_cmpeq_epi8(block, rows)));
+		if (mask != 0) {
+			return it + __builtin_ctz(mask);
+		}
+	}
+#endif
+	for (; it < end; ++it) {
+		if (*it == cellSeparator || *it == rowSeparator) {
+			return it;
+		}
+	}
+	return end;
+}
+
+/**
+	Parses the complete lines in [begin, end) and hands every requested cell to emit(column, cell).
+*/
+template <typename F>
+void parseChunk(const char *begin, const char *end, const std::vector<bool> &requested, F emit) {
+	char rowSeparator = '\n';
+	char cellSeparator = '|';
+
+	size_t column = 0;
+	const char *cell = begin;
+	while (cell < end) {
+		const char *separator = findSeparator(cell, end, cellSeparator, rowSeparator);
+		bool emptyLine = column == 0 && separator == cell && separator < end && *separator == rowSeparator;
+		// Cells after the last header column (e.g. the trailing '|' of .tbl files) are dropped
+		if (column < requested.size() && requested[column] && !emptyLine) {
+			emit(column, std::string_view(cell, separator - cell));
+		}
+		if (separator < end && *separator == rowSeparator) {
+			column = 0;
+		}
+		else {
+			++column;
+		}
+		cell = separator + 1;
+	}
+}
+
+/**
+	Splits [begin, end) into at most `threads` chunks that start right after a row separator.
+*/
+inline std::vector<std::pair<const char *, const char *>> splitChunks(const char *begin, const char *end, size_t threads) {
+	std::vector<std::pair<const char *, const char *>> chunks;
+	size_t chunkSize = (end - begin) / threads + 1;
+	const char *chunkBegin = begin;
+	while (chunkBegin < end) {
+		const char *chunkEnd = chunkBegin + std::min<size_t>(chunkSize, end - chunkBegin);
+		chunkEnd = std::find(chunkEnd, end, '\n');
+		if (chunkEnd < end) {
+			++chunkEnd;
+		}
+		chunks.emplace_back(chunkBegin, chunkEnd);
+		chunkBegin = chunkEnd;
+	}
+	return chunks;
+}
+
+/**
+	Runs parseChunk() on every chunk in its own thread. Each thread fills its own
+	per-column vectors of T, which are then concatenated in chunk order.
+*/
+template <typename T>
+std::vector<std::vector<T>> parseParallel(const MappedFile &file, const std::vector<size_t> &columns, size_t threads, bool skipHeader) {
+	const char *begin = file.data();
+	const char *end = file.data() + file.size();
+	size_t columnCount = 0;
+	{
+		const char *headerEnd = std::find(begin, end, '\n');
+		columnCount = std::count(begin, headerEnd, '|') + 1;
+		if (headerEnd > begin && headerEnd[-1] == '|') {
+			--columnCount;
+		}
+		if (skipHeader) {
+			begin = headerEnd < end ? headerEnd + 1 : end;
+		}
+	}
+	std::vector<bool> requested(columnCount, false);
+	for (auto column : columns) {
+		if (column < columnCount) {
+			requested[column] = true;
+		}
+	}
+	if (threads == 0) {
+		threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	auto chunks = splitChunks(begin, end, threads);
+	std::vector<std::vector<std::vector<T>>> partials(chunks.size(), std::vector<std::vector<T>>(columnCount));
+	std::vector<std::thread> workers;
+	for (size_t c = 0; c < chunks.size(); ++c) {
+		workers.emplace_back([&chunks, &partials, &requested, c]() {
+			auto &partial = partials[c];
+			parseChunk(chunks[c].first, chunks[c].second, requested, [&partial](size_t column, std::string_view cell) {
+				partial[column].emplace_back(cell);
+			});
+		});
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	std::vector<std::vector<T>> table(columnCount);
+	for (size_t column = 0; column < columnCount; ++column) {
+		if (!requested[column]) {
+			continue;
+		}
+		size_t rows = 0;
+		for (const auto &partial : partials) {
+			rows += partial[column].size();
+		}
+		table[column].reserve(rows);
+		for (auto &partial : partials) {
+			std::move(partial[column].begin(), partial[column].end(), std::back_inserter(table[column]));
+			partial[column] = std::vector<T>();
+		}
+	}
+	return table;
+}
+} // end namespace CSV
+
+std::vector<std::vector<std::string_view>> CSV::toColumnViews(const MappedFile &file, const std::vector<size_t> &columns, size_t threads, bool skipHeader) {
+	return parseParallel<std::string_view>(file, columns, threads, skipHeader);
+}
+
+std::vector<std::vector<std::string>> CSV::toColumnStoreParallel(std::string filePath, const std::vector<size_t> &columns, size_t threads, bool skipHeader) {
+	MappedFile file(filePath);
+	return parseParallel<std::string>(file, columns, threads, skipHeader);
+}
+
 std::vector<std::vector<std::string>> CSV::toRowStore(std::string filePath, bool skipHeader) {
 	std::vector<std::vector<std::string>> table;
 	std::ifstream infileStream(filePath);
@@ -112,7 +291,7 @@ void CSV::writeMultiLine(std::vector<std::string> &header, std::vector<std::vect
 		}
 	}
 	file << "\n";
-	for (int i = 0; i < lines[0].size(); ++i)
+	for (int i = 0; !lines.empty() && i < lines[0].size(); ++i)
 	{
 		for (int j = 0; j < lines.size(); ++j)
 		{
@@ -0,0 +1,45 @@
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdio>
+#include "csv.h"
+
+int main(int argc, char const *argv[])
+{
+	std::string filePath = "/tmp/csv_test.tbl";
+	{
+		std::ofstream file(filePath);
+		file << "ORDERKEY|ORDERSTATUS|COMMENT\n";
+		for (int i = 0; i < 1000; ++i) {
+			file << i << "|" << (i % 2 == 0 ? "O" : "F") << "|" << "a comment that is longer than sixteen bytes " << i << "|\n";
+		}
+		file << "1000|F||\n";
+	}
+	std::cout << "#### TEST PARALLEL == SEQUENTIAL ####" << std::endl;
+	{
+		auto expected = CSV::toColumnStore(filePath);
+		assert(expected[0].size() == 1001);
+		for (size_t threads : {1, 2, 3, 16}) {
+			auto table = CSV::toColumnStoreParallel(filePath, {0, 1, 2}, threads);
+			assert(table == expected);
+		}
+	}
+	std::cout << "#### TEST REQUESTED COLUMNS ####" << std::endl;
+	{
+		auto table = CSV::toColumnStoreParallel(filePath, {1}, 4);
+		assert(table.size() == 3);
+		assert(table[0].empty() && table[2].empty());
+		assert(table[1].size() == 1001);
+		assert(table[1][1] == "F" && table[1][1000] == "F");
+
+		CSV::MappedFile file(filePath);
+		auto views = CSV::toColumnViews(file, {2}, 4);
+		assert(views[2].size() == 1001);
+		assert(views[2][999] == "a comment that is longer than sixteen bytes 999");
+		assert(views[2][1000] == "");
+	}
+	std::remove(filePath.c_str());
+	return 0;
+}
@@ -0,0 +1,129 @@
+#include <cstdio>
+#include <limits>
+#include <ostream>
+
+namespace Date
+{
+
+/**
+	A calendar date stored as number of days since 1970-01-01.
+		- day<uint16_t> (date16) covers 1970-01-01 to 2149-06-06 in 2 bytes
+		- day<int32_t> (date32) covers every date we will ever see in 4 bytes
+	Comparisons are plain integer comparisons on `days`.
+*/
+template <typename T>
+struct day {
+	T days;
+
+	day() : days(0) {}
+	explicit day(T days) : days(days) {}
+
+	bool operator==(const day &other) const { return days == other.days; }
+	bool operator!=(const day &other) const { return days != other.days; }
+	bool operator<(const day &other) const { return days < other.days; }
+	bool operator<=(const day &other) const { return days <= other.days; }
+	bool operator>(const day &other) const { return days > other.days; }
+	bool operator>=(const day &other) const { return days >= other.days; }
+};
+
+using date16 = day<uint16_t>;
+using date32 = day<int32_t>;
+
+/**
+	Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's days_from_civil).
+*/
+constexpr int32_t fromCivil(int32_t year, uint32_t month, uint32_t dayOfMonth) {
+	year -= month <= 2;
+	const int32_t era = (year >= 0 ? year : year - 399) / 400;
+	const uint32_t yearOfEra = (uint32_t)(year - era * 400);
+	const uint32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + dayOfMonth - 1;
+	const uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	return era * 146097 + (int32_t)dayOfEra - 719468;
+}
+
+/**
+	Inverse of fromCivil().
+*/
+constexpr void toCivil(int32_t days, int32_t &year, uint32_t &month, uint32_t &dayOfMonth) {
+	days += 719468;
+	const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+	const uint32_t dayOfEra = (uint32_t)(days - era * 146097);
+	const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	const uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	const uint32_t mp = (5 * dayOfYear + 2) / 153;
+	dayOfMonth = dayOfYear - (153 * mp + 2) / 5 + 1;
+	month = mp < 10 ? mp + 3 : mp - 9;
+	year = (int32_t)yearOfEra + era * 400 + (month <= 2);
+}
+
+constexpr uint32_t daysInMonth(int32_t year, uint32_t month) {
+	if (month == 2) {
+		bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+		return leap ? 29 : 28;
+	}
+	return (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
+/**
+	Parses a fixed-format "YYYY-MM-DD" date without locales or streams.
+	Throws std::invalid_argument for malformed dates or dates that do not fit into T.
+*/
+template <typename T = int32_t>
+day<T> parse(const char *str, size_t length) {
+	auto digit = [str](size_t i) {
+		return (uint32_t)(str[i] - '0');
+	};
+	bool wellFormed = length == 10 && str[4] == '-' && str[7] == '-';
+	for (size_t i = 0; wellFormed && i < length; ++i) {
+		wellFormed = i == 4 || i == 7 || (str[i] >= '0' && str[i] <= '9');
+	}
+	if (!wellFormed) {
+		throw std::invalid_argument("Cannot convert " + std::string(str, length) + " to date");
+	}
+	int32_t year = digit(0) * 1000 + digit(1) * 100 + digit(2) * 10 + digit(3);
+	uint32_t month = digit(5) * 10 + digit(6);
+	uint32_t dayOfMonth = digit(8) * 10 + digit(9);
+	if (month < 1 || month > 12 || dayOfMonth < 1 || dayOfMonth > daysInMonth(year, month)) {
+		throw std::invalid_argument("Cannot convert " + std::string(str, length) + " to date");
+	}
+	int32_t days = fromCivil(year, month, dayOfMonth);
+	if (days < (int32_t)std::numeric_limits<T>::min() || days > (int32_t)std::numeric_limits<T>::max()) {
+		throw std::invalid_argument("Cannot store " + std::string(str, length) + " in " + std::to_string(sizeof(T) * 8) + " bits");
+	}
+	return day<T>((T)days);
+}
+
+template <typename T = int32_t>
+day<T> parse(const std::string &str) {
+	return parse<T>(str.data(), str.size());
+}
+
+/**
+	Formats a date as "YYYY-MM-DD".
+*/
+template <typename T>
+std::string toString(day<T> date) {
+	int32_t year;
+	uint32_t month, dayOfMonth;
+	toCivil(date.days, year, month, dayOfMonth);
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", year, month, dayOfMonth);
+	return std::string(buffer);
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, day<T> date) {
+	return os << toString(date);
+}
+
+} // end namespace Date
+
+namespace std
+{
+template <typename T>
+struct hash<Date::day<T>> {
+	size_t operator()(const Date::day<T> &date) const {
+		return std::hash<T>()(date.days);
+	}
+};
+} // end namespace std
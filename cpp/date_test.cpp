@@ -0,0 +1,48 @@
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <stdexcept>
+#include "date.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST PARSE ####" << std::endl;
+	{
+		assert(Date::parse("1970-01-01").days == 0);
+		assert(Date::parse("1970-01-02").days == 1);
+		assert(Date::parse("1969-12-31").days == -1);
+		assert(Date::parse("2000-03-01").days == 11017);
+		assert(Date::parse<uint16_t>("1996-01-02").days == 9497);
+		assert(Date::parse<uint16_t>("1992-01-01") < Date::parse<uint16_t>("1998-08-02"));
+		for (auto str : {"1x96-01-02", "1996/01/02", "1996-13-01", "1996-02-30", "1995-02-29", "96-01-02"}) {
+			bool thrown = false;
+			try {
+				Date::parse(str);
+			}
+			catch (const std::invalid_argument &e) {
+				thrown = true;
+			}
+			assert(thrown);
+		}
+		bool thrown = false;
+		try {
+			Date::parse<uint16_t>("1969-12-31");
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::cout << "#### TEST ROUNDTRIP ####" << std::endl;
+	{
+		for (int32_t days = -300000; days < 2900000; days += 7) {
+			Date::date32 date(days);
+			assert(Date::parse(Date::toString(date)) == date);
+		}
+		std::stringstream ss;
+		ss << Date::parse<uint16_t>("1996-02-29");
+		assert(ss.str() == "1996-02-29");
+	}
+	return 0;
+}
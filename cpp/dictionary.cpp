@@ -1,18 +1,26 @@
+#include <optional>
+
 namespace Dictionary
 {
 /**
-	Compresses a column:
-		- Uses a std::vector to create a sorted list of uniques
-		- Converts the std::vector to a std::unordered_map to perform O(1) lookups
-		- Returns a sorted std::vector as dictionary for decompression
+	Sorted list of the uniques of a column. Its size is the number of distinct values, e.g. to choose the code width.
 */
-template <typename D, typename C>
-std::pair<std::vector<D>, std::vector<C>> compress(const std::vector<D> &column) {
+template <typename D>
+std::vector<D> build_dictionary(const std::vector<D> &column) {
 	std::vector<D> dictionary(column.begin(), column.end());
 	std::sort(dictionary.begin(), dictionary.end());
 	auto last = std::unique(dictionary.begin(), dictionary.end());
 	dictionary.erase(last, dictionary.end());
+	return dictionary;
+}
 
+/**
+	Compresses a column with a dictionary already built by build_dictionary:
+		- Converts the std::vector to a std::unordered_map to perform O(1) lookups
+		- Returns the sorted std::vector as dictionary for decompression
+*/
+template <typename D, typename C>
+std::pair<std::vector<D>, std::vector<C>> compress(const std::vector<D> &column, std::vector<D> dictionary) {
 	std::vector<C> attributeVector(column.size());
 
 	std::unordered_map<D, C> lookup(dictionary.size());
@@ -28,7 +36,17 @@ std::pair<std::vector<D>, std::vector<C>> compress(const std::vector<D> &column)
 		attributeVector[i] = index;
 		++i;
 	}
-	return std::pair(dictionary, attributeVector);
+	return std::pair(std::move(dictionary), std::move(attributeVector));
+}
+
+/**
+	Compresses a column:
+		- Uses a std::vector to create a sorted list of uniques
+		- Encodes the column with it (see above)
+*/
+template <typename D, typename C>
+std::pair<std::vector<D>, std::vector<C>> compress(const std::vector<D> &column) {
+	return compress<D, C>(column, build_dictionary(column));
 }
 
 
@@ -58,6 +76,33 @@ std::vector<D> partial_decompress(std::pair<std::vector<D>, std::vector<C>> &com
 	return decompressed;
 }
 
+/**
+	Rows per zone. Small enough that zones of clustered columns (e.g. dates in load order) cover narrow code ranges.
+*/
+const size_t ZONE_SIZE = 1 << 12;
+
+/**
+	Zone map of a compressed column: bounds[z] is the smallest and largest code of the rows
+	[z * zoneSize, (z + 1) * zoneSize). Codes are ordered like the values, so zones can be skipped by code alone.
+*/
+template <typename C>
+struct zoneMap {
+	size_t zoneSize = ZONE_SIZE;
+	std::vector<std::pair<C, C>> bounds;
+};
+
+template <typename D, typename C>
+zoneMap<C> build_zone_map(const std::pair<std::vector<D>, std::vector<C>> &compressed, size_t zoneSize = ZONE_SIZE) {
+	zoneMap<C> zones;
+	zones.zoneSize = zoneSize;
+	const auto &codes = compressed.second;
+	for (size_t first = 0; first < codes.size(); first += zoneSize) {
+		auto [min, max] = std::minmax_element(codes.begin() + first, codes.begin() + std::min(first + zoneSize, codes.size()));
+		zones.bounds.emplace_back(*min, *max);
+	}
+	return zones;
+}
+
 // ---------------------- INTERNAL ------------------ //
 
 /**
@@ -123,6 +168,97 @@ std::vector<size_t> where_view(std::pair<std::vector<D>, std::vector<C>> &compre
 	return vector_view;
 }
 
+/**
+	Calls fn(first, last, full, matches) for every zone which may hold a row matching the predicate:
+		- matches[code] is 1 if the dictionary value of code matches
+		- full is true if every code in the zone bounds matches, the rows [first, last) need no check
+	Zones whose code range holds no matching code are skipped.
+*/
+template <typename D, typename C, typename F>
+void for_each_zone(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate, F fn) {
+	auto dictionary_view = vector_view<D, C>(compressed.first, predicate);
+	std::vector<uint8_t> matches(compressed.first.size(), 0);
+	for (auto code : dictionary_view) {
+		matches[code] = 1;
+	}
+	for (size_t z = 0; z < zones.bounds.size(); ++z) {
+		auto [min, max] = zones.bounds[z];
+		// dictionary_view is sorted, so the matching codes within the bounds are contiguous in it
+		auto begin = std::lower_bound(dictionary_view.begin(), dictionary_view.end(), min);
+		auto end = std::upper_bound(begin, dictionary_view.end(), max);
+		if (begin == end) {
+			continue;
+		}
+		size_t first = z * zones.zoneSize;
+		size_t last = std::min(first + zones.zoneSize, compressed.second.size());
+		fn(first, last, size_t(end - begin) == size_t(max - min) + 1, matches);
+	}
+}
+
+/**
+	where_copy() with a zone map: zones without a matching code are skipped, fully matching zones are copied as is.
+*/
+template <typename D, typename C>
+std::vector<C> where_copy(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	std::vector<C> copy_view;
+	for_each_zone(compressed, zones, predicate, [&](size_t first, size_t last, bool full, const std::vector<uint8_t> &matches) {
+		auto begin = compressed.second.begin() + first;
+		auto end = compressed.second.begin() + last;
+		if (full) {
+			copy_view.insert(copy_view.end(), begin, end);
+		}
+		else {
+			std::copy_if(begin, end, std::back_inserter(copy_view), [&matches](C code) { return matches[code]; });
+		}
+	});
+	return copy_view;
+}
+
+/**
+	where_view() with a zone map: zones without a matching code are skipped, fully matching zones need no check per row.
+*/
+template <typename D, typename C>
+std::vector<size_t> where_view(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	std::vector<size_t> vector_view;
+	for_each_zone(compressed, zones, predicate, [&](size_t first, size_t last, bool full, const std::vector<uint8_t> &matches) {
+		for (size_t i = first; i < last; ++i) {
+			if (full || matches[compressed.second[i]]) {
+				vector_view.push_back(i);
+			}
+		}
+	});
+	return vector_view;
+}
+
+/**
+	Returns the codes [first, second) of all dictionary values in [from, to).
+	The dictionary is sorted, so a value range is a contiguous code range found with two binary searches.
+*/
+template <typename D>
+std::pair<size_t, size_t> code_range(const std::vector<D> &dictionary, std::optional<D> from, std::optional<D> to) {
+	size_t first = from ? std::lower_bound(dictionary.begin(), dictionary.end(), *from) - dictionary.begin() : 0;
+	size_t second = to ? std::lower_bound(dictionary.begin(), dictionary.end(), *to) - dictionary.begin() : dictionary.size();
+	return std::pair(first, std::max(first, second));
+}
+
+/**
+	Returns indices of all values in [from, to).
+	1. Translate the value range into a code range with code_range().
+	2. Scan the attribute vector with two integer comparisons per row.
+*/
+template <typename D, typename C>
+std::vector<size_t> where_view_range(std::pair<std::vector<D>, std::vector<C>> &compressed, std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = code_range(compressed.first, from, to);
+	std::vector<size_t> vector_view;
+	for (size_t i = 0; i < compressed.second.size(); ++i)
+	{
+		if (compressed.second[i] >= first && compressed.second[i] < second) {
+			vector_view.push_back(i);
+		}
+	}
+	return vector_view;
+}
+
 
 // ---------------------- OPS ------------------ //
 
@@ -137,6 +273,37 @@ size_t count_where_op(std::pair<std::vector<D>, std::vector<C>> &compressed, std
 	return attributeVectorWhere.size();
 }
 
+/**
+	Counts all values matching the predicate, fully matching zones are counted without touching their rows.
+*/
+template <typename D, typename C>
+size_t count_where_op(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	size_t count = 0;
+	for_each_zone(compressed, zones, predicate, [&](size_t first, size_t last, bool full, const std::vector<uint8_t> &matches) {
+		if (full) {
+			count += last - first;
+			return;
+		}
+		for (size_t i = first; i < last; ++i) {
+			count += matches[compressed.second[i]];
+		}
+	});
+	return count;
+}
+
+/**
+	Counts all values in [from, to). See where_view_range().
+*/
+template <typename D, typename C>
+size_t count_where_op_range(std::pair<std::vector<D>, std::vector<C>> &compressed, std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = code_range(compressed.first, from, to);
+	size_t count = 0;
+	for (auto cell : compressed.second) {
+		count += cell >= first && cell < second;
+	}
+	return count;
+}
+
 template <typename D, typename C>
 D max_op(std::pair<std::vector<D>, std::vector<C>> &compressed) {
 	return compressed.first[compressed.first.size() - 1];
@@ -158,6 +325,12 @@ std::vector<D> where_view_op(std::pair<std::vector<D>, std::vector<C>> &compress
 	return partial_decompress(compressed, attributeVectorWhere);
 }
 
+template <typename D, typename C>
+std::vector<D> where_view_op(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	auto attributeVectorWhere = where_view(compressed, zones, predicate);
+	return partial_decompress(compressed, attributeVectorWhere);
+}
+
 /**
 	Search for values matching a predicate.
 	1. Call where_copy().
@@ -170,6 +343,13 @@ std::vector<D> where_copy_op(std::pair<std::vector<D>, std::vector<C>> &compress
 	return decompress(temp_compressed);
 }
 
+template <typename D, typename C>
+std::vector<D> where_copy_op(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	auto attributeVectorWhere = where_copy(compressed, zones, predicate);
+	auto temp_compressed = std::pair(compressed.first, attributeVectorWhere);
+	return decompress(temp_compressed);
+}
+
 /**
 	Calculates the sum of all values in a column.
 */
@@ -177,6 +357,9 @@ template <typename D, typename C>
 size_t sum_op(std::pair<std::vector<D>, std::vector<C>> &compressed) {
 	size_t total_sum = 0;
 	auto attributeVector = compressed.second;
+	if (attributeVector.empty()) {
+		return 0;
+	}
 	if (compressed.first.size() == 1) {
 		// If we have only a single unique just multiply it with the attribute vector size
 		total_sum = compressed.first[0] * compressed.second.size();
@@ -197,11 +380,9 @@ size_t sum_op(std::pair<std::vector<D>, std::vector<C>> &compressed) {
 				lastValue = attributeVector[i];
 				lastValueCount = 1;
 			}
-			if (i + 1 == attributeVector.size()) {
-				// End of loop
-				total_sum += compressed.first[lastValue] * lastValueCount;
-			}
 		}
+		// Last value, also if the vector holds a single row
+		total_sum += compressed.first[lastValue] * lastValueCount;
 	}
 	return total_sum;
 }
@@ -218,6 +399,13 @@ size_t sum_where_copy_op(std::pair<std::vector<D>, std::vector<C>> &compressed,
 	return sum_op(temp_compressed);
 }
 
+template <typename D, typename C>
+size_t sum_where_copy_op(std::pair<std::vector<D>, std::vector<C>> &compressed, const zoneMap<C> &zones, std::function<bool (D)> predicate) {
+	auto attributeVectorWhere = where_copy(compressed, zones, predicate);
+	auto temp_compressed = std::pair(compressed.first, attributeVectorWhere);
+	return sum_op(temp_compressed);
+}
+
 /**
 	Calculates the average of all values in a column.
 	IF (size==1) -> average = first element
@@ -240,6 +428,61 @@ float avg_op(std::pair<std::vector<D>, std::vector<C>> &compressed) {
 	return avg;
 }
 
+/**
+	DISTINCT: the dictionary holds exactly the distinct values of the column, already sorted.
+*/
+template <typename D, typename C>
+std::vector<D> distinct_op(const std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return compressed.first;
+}
+
+template <typename D, typename C>
+size_t count_distinct_op(const std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return compressed.first.size();
+}
+
+/**
+	DISTINCT under a predicate on the same column: every dictionary entry occurs, so the predicate is evaluated per entry.
+*/
+template <typename D, typename C>
+std::vector<D> distinct_where_op(const std::pair<std::vector<D>, std::vector<C>> &compressed, std::function<bool (D)> predicate) {
+	std::vector<D> result;
+	std::copy_if(compressed.first.begin(), compressed.first.end(), std::back_inserter(result), predicate);
+	return result;
+}
+
+/**
+	Codes occurring in the selected rows (e.g. from a filter on another column), one bit per dictionary entry.
+*/
+template <typename D, typename C>
+std::vector<bool> seen_codes(const std::pair<std::vector<D>, std::vector<C>> &compressed, const std::vector<size_t> &rows) {
+	std::vector<bool> seen(compressed.first.size(), false);
+	for (auto row : rows) {
+		seen[compressed.second[row]] = true;
+	}
+	return seen;
+}
+
+/**
+	DISTINCT over the selected rows, sorted: seen codes are collected in code order.
+*/
+template <typename D, typename C>
+std::vector<D> distinct_op(const std::pair<std::vector<D>, std::vector<C>> &compressed, const std::vector<size_t> &rows) {
+	auto seen = seen_codes(compressed, rows);
+	std::vector<D> result;
+	for (size_t code = 0; code < seen.size(); ++code) {
+		if (seen[code]) {
+			result.push_back(compressed.first[code]);
+		}
+	}
+	return result;
+}
+
+template <typename D, typename C>
+size_t count_distinct_op(const std::pair<std::vector<D>, std::vector<C>> &compressed, const std::vector<size_t> &rows) {
+	auto seen = seen_codes(compressed, rows);
+	return std::count(seen.begin(), seen.end(), true);
+}
 
 // ---------------------- BENCHMARK ------------------ //
 
@@ -16,6 +16,7 @@
 #include <iomanip>
 #include <sstream>
 #include "allocator.cpp"
+#include "date.cpp"
 #include "benchmark.cpp"
 #include "dictionary.cpp"
 
@@ -151,38 +152,78 @@ int main(int argc, char const *argv[])
 	std::cout << "#### TEST WITH STD::STRING + DATES ####" << std::endl;
 	{
 		std::vector<std::string> column = {"1996-01-02", "1995-01-03", "1995-01-04", "1995-01-05"};
-		std::vector<std::time_t> convertedColumn;
-		auto transform_fn = [](const std::string & str) {
-			std::tm t = {};
-			std::istringstream ss(str);
-			ss >> std::get_time(&t, "%Y-%m-%d");
-			if (ss.fail()) {
-				throw std::invalid_argument("Cannot convert " + str + " to time");
-			}
-			return std::mktime(&t);
-		};
-		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), transform_fn);
-		auto compressedColumn = Dictionary::compress<std::time_t, uint8_t>(convertedColumn);
-		// 1996-01-02
-		std::tm date;
-		date.tm_mon = 0;
-		date.tm_sec = 0;
-		date.tm_min = 0;
-		date.tm_hour = 0;
-		date.tm_wday = 0;
-		date.tm_yday = 0;
-		date.tm_year = 96;
-		date.tm_mday = 2;
-		std::function<bool (std::time_t)> predicate = [&date](std::time_t i) {
-			// 1996-01-02
-			return i < std::mktime(&date);
+		std::vector<Date::date16> convertedColumn;
+		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), [](const std::string & str) {
+			return Date::parse<uint16_t>(str);
+		});
+		auto compressedColumn = Dictionary::compress<Date::date16, uint8_t>(convertedColumn);
+		assert(convertedColumn == Dictionary::decompress(compressedColumn));
+		auto date = Date::parse<uint16_t>("1996-01-02");
+		std::function<bool (Date::date16)> predicate = [date](Date::date16 i) {
+			return i < date;
 		};
 		auto where = Dictionary::where_view_op(compressedColumn, predicate);
-		for (auto t : convertedColumn) {
-			std::cout << t << std::endl;
-		}
 		std::cout << where.size() << std::endl;
-		// assert(where.size() == 3);
+		assert(where.size() == 3);
+		assert((Dictionary::count_where_op_range<Date::date16, uint8_t>(compressedColumn, {}, date) == 3));
+		assert((Dictionary::count_where_op_range<Date::date16, uint8_t>(compressedColumn, Date::parse<uint16_t>("1995-01-04"), {}) == 3));
+		std::vector<size_t> expectedView = {1, 2};
+		assert((Dictionary::where_view_range<Date::date16, uint8_t>(compressedColumn, Date::parse<uint16_t>("1995-01-03"), Date::parse<uint16_t>("1995-01-05")) == expectedView));
+	}
+	std::cout << "#### TEST ZONE MAPS ####" << std::endl;
+	{
+		// Clustered column: values grow with the row number, with a few outliers
+		std::vector<int> column;
+		for (int i = 0; i < 10000; ++i) {
+			column.push_back(i % 997 == 0 ? 5000 : i / 10);
+		}
+		auto compressedColumn = Dictionary::compress<int, uint16_t>(column);
+		auto zones = Dictionary::build_zone_map(compressedColumn, 256);
+		assert(zones.bounds.size() == 40);
+		for (auto predicate : {std::function<bool (int)>([](int v) { return v < 300; }),
+		                       std::function<bool (int)>([](int v) { return v >= 450 && v < 460; }),
+		                       std::function<bool (int)>([](int v) { return v % 2 == 0; }),
+		                       std::function<bool (int)>([](int v) { return v > 5000; })}) {
+			assert(Dictionary::where_view(compressedColumn, zones, predicate) == Dictionary::where_view(compressedColumn, predicate));
+			assert(Dictionary::where_copy(compressedColumn, zones, predicate) == Dictionary::where_copy(compressedColumn, predicate));
+			assert(Dictionary::where_view_op(compressedColumn, zones, predicate) == Dictionary::where_view_op(compressedColumn, predicate));
+			assert(Dictionary::where_copy_op(compressedColumn, zones, predicate) == Dictionary::where_copy_op(compressedColumn, predicate));
+			assert(Dictionary::count_where_op(compressedColumn, zones, predicate) == Dictionary::count_where_op(compressedColumn, predicate));
+			assert(Dictionary::sum_where_copy_op(compressedColumn, zones, predicate) == Dictionary::sum_where_copy_op(compressedColumn, predicate));
+		}
+		size_t visited = 0;
+		size_t full = 0;
+		std::function<bool (int)> predicate = [](int v) { return v < 300; };
+		Dictionary::for_each_zone(compressedColumn, zones, predicate, [&](size_t first, size_t last, bool isFull, const std::vector<uint8_t> &) {
+			++visited;
+			full += isFull;
+		});
+		// Zones 0, 3, 7 and 11 hold an outlier, zone 11 also rows >= 300
+		assert(visited == 12 && full == 8);
+
+		// A filtered copy may hold a single row
+		std::pair<std::vector<int>, std::vector<uint16_t>> single = {{7, 9}, {1}};
+		assert(Dictionary::sum_op(single) == 9);
+	}
+	std::cout << "#### TEST DISTINCT ####" << std::endl;
+	{
+		std::vector<int> column = {5, 3, 5, 9, 1, 3, 9, 9, 7};
+		auto compressedColumn = Dictionary::compress<int, uint8_t>(column);
+		auto dictionary = Dictionary::build_dictionary(column);
+		assert(dictionary.size() == 5);
+		assert((Dictionary::compress<int, uint8_t>(column, dictionary) == compressedColumn));
+		assert((Dictionary::count_distinct_op(compressedColumn) == 5));
+		std::vector<int> expected = {1, 3, 5, 7, 9};
+		assert(Dictionary::distinct_op(compressedColumn) == expected);
+		expected = {1, 3};
+		assert(Dictionary::distinct_where_op(compressedColumn, std::function<bool (int)>([](int v) { return v < 5; })) == expected);
+
+		// Rows selected by a filter on another column: codes of rows 1, 2, 5 and 8
+		std::vector<size_t> rows = {1, 2, 5, 8};
+		expected = {3, 5, 7};
+		assert(Dictionary::distinct_op(compressedColumn, rows) == expected);
+		assert((Dictionary::count_distinct_op(compressedColumn, rows) == 3));
+		assert((Dictionary::count_distinct_op(compressedColumn, std::vector<size_t>()) == 0));
 	}
 	return 0;
 }
\ No newline at end of file
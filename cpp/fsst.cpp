@@ -0,0 +1,422 @@
+#include <array>
+#include <optional>
+#include <cstring>
+
+namespace FSST
+{
+
+/**
+	Code 255 is reserved: it is followed by one literal byte that no symbol covers.
+*/
+const uint8_t ESCAPE = 255;
+const size_t MAX_SYMBOLS = 255;
+const size_t MAX_SYMBOL_LENGTH = 8;
+
+struct symbolTable {
+	// code -> symbol (1 - 8 bytes)
+	std::vector<std::string> symbols;
+	// first byte -> codes starting with that byte, longest symbol first
+	std::array<std::vector<uint8_t>, 256> candidates;
+};
+
+struct compressedData {
+	symbolTable table;
+	std::vector<uint8_t> bytes;
+	// String i is bytes[offsets[i], offsets[i + 1])
+	std::vector<size_t> offsets;
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+/**
+	Rebuilds the first-byte lookup after the symbols changed.
+*/
+void buildCandidates(symbolTable &table) {
+	for (auto &candidates : table.candidates) {
+		candidates.clear();
+	}
+	for (size_t code = 0; code < table.symbols.size(); ++code) {
+		table.candidates[(uint8_t)table.symbols[code][0]].push_back(code);
+	}
+	for (auto &candidates : table.candidates) {
+		std::stable_sort(candidates.begin(), candidates.end(), [&table](uint8_t a, uint8_t b) {
+			return table.symbols[a].size() > table.symbols[b].size();
+		});
+	}
+}
+
+/**
+	Returns the longest symbol matching str at pos or -1 if the byte has to be escaped.
+*/
+int findSymbol(const symbolTable &table, const char *str, size_t remaining) {
+	for (auto code : table.candidates[(uint8_t)str[0]]) {
+		const auto &symbol = table.symbols[code];
+		if (symbol.size() <= remaining && std::memcmp(symbol.data(), str, symbol.size()) == 0) {
+			return code;
+		}
+	}
+	return -1;
+}
+
+/**
+	Appends the encoding of str to out. Greedy longest match, so equal strings
+	always produce equal bytes.
+*/
+void encode(const symbolTable &table, const std::string &str, std::vector<uint8_t> &out) {
+	size_t pos = 0;
+	while (pos < str.size()) {
+		int code = findSymbol(table, str.data() + pos, str.size() - pos);
+		if (code < 0) {
+			out.push_back(ESCAPE);
+			out.push_back((uint8_t)str[pos]);
+			++pos;
+		}
+		else {
+			out.push_back((uint8_t)code);
+			pos += table.symbols[code].size();
+		}
+	}
+}
+
+/**
+	Appends the decoded bytes [begin, end) to out.
+*/
+void decode(const symbolTable &table, const uint8_t *begin, const uint8_t *end, std::string &out) {
+	while (begin < end) {
+		if (*begin == ESCAPE) {
+			out.push_back((char)begin[1]);
+			begin += 2;
+		}
+		else {
+			out.append(table.symbols[*begin]);
+			++begin;
+		}
+	}
+}
+
+// ---------------------- COMPRESS ------------------ //
+
+/**
+	Learns a symbol table from (a sample of) the column:
+		- Encodes the sample with the current table and counts symbols and pairs of adjacent symbols
+		- Escaped bytes count as single byte pseudo symbols
+		- Keeps the MAX_SYMBOLS candidates (symbols and concatenations of pairs up to 8 bytes) with the highest gain (count * length)
+		- Repeats for a few generations, so symbols can grow up to 8 bytes
+*/
+symbolTable train(const std::vector<std::string> &column, size_t sampleBytes = 1 << 16, size_t generations = 5) {
+	std::vector<const std::string *> sample;
+	size_t sampled = 0;
+	size_t step = std::max<size_t>(1, column.size() / std::max<size_t>(1, sampleBytes / 32));
+	for (size_t i = 0; i < column.size() && sampled < sampleBytes; i += step) {
+		sample.push_back(&column[i]);
+		sampled += column[i].size();
+	}
+
+	symbolTable table;
+	// Extended codes: [0, 255) symbols, [256, 512) escaped bytes
+	const size_t extended = 512;
+	for (size_t generation = 0; generation < generations; ++generation) {
+		std::vector<size_t> single(extended, 0);
+		std::vector<size_t> pairs(extended * extended, 0);
+		auto symbolOf = [&table](size_t code) {
+			return code < 256 ? table.symbols[code] : std::string(1, (char)(code - 256));
+		};
+		for (auto str : sample) {
+			size_t pos = 0;
+			int previous = -1;
+			while (pos < str->size()) {
+				int code = findSymbol(table, str->data() + pos, str->size() - pos);
+				size_t current = code < 0 ? 256 + (uint8_t)(*str)[pos] : code;
+				pos += code < 0 ? 1 : table.symbols[code].size();
+				++single[current];
+				if (previous >= 0) {
+					++pairs[previous * extended + current];
+				}
+				previous = current;
+			}
+		}
+
+		// Gain of each candidate, merged by symbol as a concatenation can equal an existing symbol
+		std::unordered_map<std::string, size_t> gains;
+		for (size_t code = 0; code < extended; ++code) {
+			if (single[code] == 0) {
+				continue;
+			}
+			auto symbol = symbolOf(code);
+			gains[symbol] += single[code] * symbol.size();
+			for (size_t next = 0; next < extended; ++next) {
+				auto count = pairs[code * extended + next];
+				if (count == 0) {
+					continue;
+				}
+				auto concatenated = symbol + symbolOf(next);
+				if (concatenated.size() <= MAX_SYMBOL_LENGTH) {
+					gains[concatenated] += count * concatenated.size();
+				}
+			}
+		}
+		std::vector<std::pair<size_t, std::string>> ranked;
+		ranked.reserve(gains.size());
+		for (auto const& [symbol, gain] : gains) {
+			ranked.emplace_back(gain, symbol);
+		}
+		// Highest gain first, ties broken by symbol to stay deterministic
+		std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+			return a.first != b.first ? a.first > b.first : a.second < b.second;
+		});
+		table.symbols.clear();
+		for (size_t i = 0; i < ranked.size() && i < MAX_SYMBOLS; ++i) {
+			table.symbols.push_back(ranked[i].second);
+		}
+		buildCandidates(table);
+	}
+	return table;
+}
+
+/**
+	Compresses a column:
+		- Trains a symbol table on a sample of the column
+		- Encodes every string into one contiguous byte vector
+		- Stores one offset per string for random access
+*/
+compressedData compress(const std::vector<std::string> &column) {
+	compressedData compressed;
+	compressed.table = train(column);
+	compressed.offsets.reserve(column.size() + 1);
+	compressed.offsets.push_back(0);
+	for (const auto &cell : column) {
+		encode(compressed.table, cell, compressed.bytes);
+		compressed.offsets.push_back(compressed.bytes.size());
+	}
+	compressed.bytes.shrink_to_fit();
+	return compressed;
+}
+
+/**
+	Decompresses a single string (random access).
+*/
+std::string decompress_at(const compressedData &compressed, size_t index) {
+	std::string decompressed;
+	decode(compressed.table, compressed.bytes.data() + compressed.offsets[index],
+	       compressed.bytes.data() + compressed.offsets[index + 1], decompressed);
+	return decompressed;
+}
+
+/**
+	Decompresses a column.
+*/
+std::vector<std::string> decompress(const compressedData &compressed) {
+	std::vector<std::string> decompressed;
+	decompressed.reserve(compressed.offsets.size() - 1);
+	for (size_t i = 0; i + 1 < compressed.offsets.size(); ++i) {
+		decompressed.push_back(decompress_at(compressed, i));
+	}
+	return decompressed;
+}
+
+/**
+	Partially decompresses a column. Only the rows in `indices`.
+*/
+std::vector<std::string> partial_decompress(const compressedData &compressed, const std::vector<size_t> &indices) {
+	std::vector<std::string> decompressed;
+	decompressed.reserve(indices.size());
+	for (auto index : indices) {
+		decompressed.push_back(decompress_at(compressed, index));
+	}
+	return decompressed;
+}
+
+// ---------------------- PREDICATES ------------------ //
+
+/**
+	Checks if string `index` starts with prefix by walking its codes and comparing
+	symbol bytes in place. Stops at the first mismatch without decoding the rest.
+*/
+bool starts_with(const compressedData &compressed, size_t index, const std::string &prefix) {
+	const uint8_t *it = compressed.bytes.data() + compressed.offsets[index];
+	const uint8_t *end = compressed.bytes.data() + compressed.offsets[index + 1];
+	size_t matched = 0;
+	while (matched < prefix.size()) {
+		if (it >= end) {
+			return false;
+		}
+		if (*it == ESCAPE) {
+			if ((char)it[1] != prefix[matched]) {
+				return false;
+			}
+			++matched;
+			it += 2;
+		}
+		else {
+			const auto &symbol = compressed.table.symbols[*it];
+			size_t length = std::min(symbol.size(), prefix.size() - matched);
+			if (std::memcmp(symbol.data(), prefix.data() + matched, length) != 0) {
+				return false;
+			}
+			matched += length;
+			++it;
+		}
+	}
+	return true;
+}
+
+/**
+	Matches a SQL LIKE pattern ('%' = any sequence, '_' = any byte) against str.
+*/
+bool like(const char *str, size_t strLength, const std::string &pattern) {
+	size_t s = 0, p = 0;
+	size_t starPattern = std::string::npos, starString = 0;
+	while (s < strLength) {
+		if (p < pattern.size() && (pattern[p] == '_' || pattern[p] == str[s])) {
+			++s;
+			++p;
+		}
+		else if (p < pattern.size() && pattern[p] == '%') {
+			starPattern = p++;
+			starString = s;
+		}
+		else if (starPattern != std::string::npos) {
+			p = starPattern + 1;
+			s = ++starString;
+		}
+		else {
+			return false;
+		}
+	}
+	while (p < pattern.size() && pattern[p] == '%') {
+		++p;
+	}
+	return p == pattern.size();
+}
+
+/**
+	Returns the literal prefix of a LIKE pattern if the pattern is "<literal>%", otherwise std::nullopt.
+*/
+std::optional<std::string> likePrefix(const std::string &pattern) {
+	auto wildcard = pattern.find_first_of("%_");
+	if (wildcard == std::string::npos || wildcard + 1 != pattern.size() || pattern[wildcard] != '%') {
+		return std::nullopt;
+	}
+	return pattern.substr(0, wildcard);
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Returns indices of all strings equal to value.
+	The value is encoded once with the column's symbol table, every row is then a length check plus memcmp on compressed bytes.
+*/
+std::vector<size_t> where_view_equal(const compressedData &compressed, const std::string &value) {
+	std::vector<uint8_t> encoded;
+	encode(compressed.table, value, encoded);
+	std::vector<size_t> view;
+	for (size_t i = 0; i + 1 < compressed.offsets.size(); ++i) {
+		size_t length = compressed.offsets[i + 1] - compressed.offsets[i];
+		if (length == encoded.size() && std::memcmp(compressed.bytes.data() + compressed.offsets[i], encoded.data(), length) == 0) {
+			view.push_back(i);
+		}
+	}
+	return view;
+}
+
+size_t count_where_op_equal(const compressedData &compressed, const std::string &value) {
+	return where_view_equal(compressed, value).size();
+}
+
+/**
+	Returns indices of all strings starting with prefix. See starts_with().
+*/
+std::vector<size_t> where_view_prefix(const compressedData &compressed, const std::string &prefix) {
+	std::vector<size_t> view;
+	for (size_t i = 0; i + 1 < compressed.offsets.size(); ++i) {
+		if (starts_with(compressed, i, prefix)) {
+			view.push_back(i);
+		}
+	}
+	return view;
+}
+
+size_t count_where_op_prefix(const compressedData &compressed, const std::string &prefix) {
+	return where_view_prefix(compressed, prefix).size();
+}
+
+/**
+	Returns indices of all strings matching a LIKE pattern.
+		- "<literal>%" is answered by where_view_prefix() on compressed bytes
+		- Everything else decodes each string into one reused buffer and matches it there
+*/
+std::vector<size_t> where_view_like(const compressedData &compressed, const std::string &pattern) {
+	if (auto prefix = likePrefix(pattern)) {
+		return where_view_prefix(compressed, *prefix);
+	}
+	std::vector<size_t> view;
+	std::string buffer;
+	for (size_t i = 0; i + 1 < compressed.offsets.size(); ++i) {
+		buffer.clear();
+		decode(compressed.table, compressed.bytes.data() + compressed.offsets[i],
+		       compressed.bytes.data() + compressed.offsets[i + 1], buffer);
+		if (like(buffer.data(), buffer.size(), pattern)) {
+			view.push_back(i);
+		}
+	}
+	return view;
+}
+
+size_t count_where_op_like(const compressedData &compressed, const std::string &pattern) {
+	return where_view_like(compressed, pattern).size();
+}
+
+// ---------------------- BENCHMARK ------------------ //
+
+Benchmark::CompressionResult benchmark(const std::vector<std::string> &column, int runs, int warmup, bool clearCache) {
+	std::cout << "FSST - Compressing column" << std::endl;
+	auto compressedColumn = compress(column);
+	std::cout << "FSST - Decompressing column" << std::endl;
+	assert(column == decompress(compressedColumn));
+	std::function<compressedData ()> compressFunction = [&column]() {
+		return compress(column);
+	};
+	std::function<std::vector<std::string> ()> decompressFunction = [&compressedColumn]() {
+		return decompress(compressedColumn);
+	};
+	std::cout << "FSST - Benchmarking Compression" << std::endl;
+	auto compressRuntimes = Benchmark::benchmark(compressFunction, runs, warmup, clearCache);
+	std::cout << "FSST - Benchmarking Decompression" << std::endl;
+	auto decompressRuntimes = Benchmark::benchmark(decompressFunction, runs, warmup, clearCache);
+
+	// Compressed Size
+	size_t cSize = sizeof(compressedColumn);
+	{
+		std::vector<std::string, MyAllocator<std::string>> symbolsWithAlloc(compressedColumn.table.symbols.begin(), compressedColumn.table.symbols.end());
+		cSize += symbolsWithAlloc.get_allocator().allocationInByte();
+		for (const auto &symbol : compressedColumn.table.symbols) {
+			cSize += sizeOfString(symbol);
+		}
+		std::vector<uint8_t, MyAllocator<uint8_t>> bytesWithAlloc(compressedColumn.bytes.begin(), compressedColumn.bytes.end());
+		cSize += bytesWithAlloc.get_allocator().allocationInByte();
+		std::vector<size_t, MyAllocator<size_t>> offsetsWithAlloc(compressedColumn.offsets.begin(), compressedColumn.offsets.end());
+		cSize += offsetsWithAlloc.get_allocator().allocationInByte();
+	}
+	// Uncompressed Size
+	std::vector<std::string, MyAllocator<std::string>> uncompressedWithAlloc(column.begin(), column.end());
+	size_t uSize = uncompressedWithAlloc.get_allocator().allocationInByte();
+	uSize += sizeof(column);
+	for (const auto &v : column) {
+		uSize += sizeOfString(v);
+	}
+	return Benchmark::CompressionResult(compressRuntimes, decompressRuntimes, cSize, uSize);
+}
+
+/**
+	R == OP return type
+*/
+template <typename R>
+std::vector<size_t> benchmark_op(const compressedData &compressedColumn, int runs, int warmup, bool clearCache,
+                                 std::function<R (const compressedData&)> func) {
+	std::function<R ()> fn = [&compressedColumn, &func]() {
+		return func(compressedColumn);
+	};
+	return Benchmark::benchmark(fn, runs, warmup, clearCache);
+}
+
+} // end namespace FSST
@@ -0,0 +1,66 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "fsst.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST ROUNDTRIP ####" << std::endl;
+	{
+		std::vector<std::string> column = {
+			"carefully final deposits sleep",
+			"furiously special requests",
+			"",
+			"special requests sleep carefully",
+			"\xff\x01 binary bytes escape",
+			"furiously special requests",
+		};
+		auto compressedColumn = FSST::compress(column);
+		assert(compressedColumn.table.symbols.size() <= FSST::MAX_SYMBOLS);
+		for (const auto &symbol : compressedColumn.table.symbols) {
+			assert(symbol.size() >= 1 && symbol.size() <= FSST::MAX_SYMBOL_LENGTH);
+		}
+		assert(column == FSST::decompress(compressedColumn));
+		assert(FSST::decompress_at(compressedColumn, 3) == column[3]);
+		std::vector<size_t> indices = {4, 0};
+		std::vector<std::string> expectedPartial = {column[4], column[0]};
+		assert(FSST::partial_decompress(compressedColumn, indices) == expectedPartial);
+	}
+	std::cout << "#### TEST PREDICATES ####" << std::endl;
+	{
+		std::vector<std::string> column;
+		for (int i = 0; i < 1000; ++i) {
+			column.push_back(i % 3 == 0 ? "ironic packages sleep quickly " + std::to_string(i) : "regular accounts haggle " + std::to_string(i));
+		}
+		auto compressedColumn = FSST::compress(column);
+		assert(column == FSST::decompress(compressedColumn));
+		assert(compressedColumn.bytes.size() < 1000 * 25);
+
+		assert(FSST::count_where_op_equal(compressedColumn, "regular accounts haggle 1") == 1);
+		assert(FSST::count_where_op_equal(compressedColumn, "regular accounts haggle") == 0);
+		assert(FSST::count_where_op_equal(compressedColumn, "unknown\x01") == 0);
+
+		std::vector<size_t> expectedView = {10, 100};
+		auto view = FSST::where_view_prefix(compressedColumn, "regular accounts haggle 10");
+		view.resize(std::min<size_t>(view.size(), 2));
+		assert(view == expectedView);
+		assert(FSST::count_where_op_prefix(compressedColumn, "ironic") == 334);
+		assert(FSST::count_where_op_prefix(compressedColumn, "") == 1000);
+		assert(FSST::count_where_op_prefix(compressedColumn, "regular accounts haggle 9999") == 0);
+
+		assert(FSST::count_where_op_like(compressedColumn, "ironic%") == 334);
+		assert(FSST::count_where_op_like(compressedColumn, "%haggle 99_") == 6);
+		assert(FSST::count_where_op_like(compressedColumn, "%sleep%") == 334);
+		assert(FSST::count_where_op_like(compressedColumn, "%") == 1000);
+		assert(FSST::count_where_op_like(compressedColumn, "regular%1") == 67);
+	}
+	return 0;
+}
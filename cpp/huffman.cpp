@@ -1,13 +1,72 @@
 #include <optional>
+#include <type_traits>
+#include <unordered_set>
 
 namespace Huffman
 {
 
+/**
+	Pre-aggregates of one block: number of values, their sum and their sum of squares.
+	Sums are only collected for arithmetic types.
+*/
+struct blockAggregate {
+	size_t count = 0;
+	double sum = 0;
+	double sumOfSquares = 0;
+
+	template <typename D>
+	void add(const D &value) {
+		++count;
+		if constexpr (std::is_arithmetic_v<D>) {
+			sum += (double)value;
+			sumOfSquares += (double)value * (double)value;
+		}
+	}
+};
+
+/**
+	A 64 bit block only holds a handful of values, so membership filters cover groups of FILTER_BLOCKS blocks.
+*/
+const size_t FILTER_BLOCKS = 64;
+
+/**
+	Columns with at most this many distinct values get an exact bitset over dictionary ids, all others a Bloom filter.
+*/
+const size_t FILTER_MAX_IDS = 1 << 12;
+
+const size_t BLOOM_BITS_PER_VALUE = 10;
+const size_t BLOOM_HASHES = 4;
+
+enum class FilterKind {
+	None,
+	Bitset,
+	Bloom,
+};
+
+/**
+	Membership filters, one per group of blocksPerFilter blocks. Filter g covers the blocks
+	[g * blocksPerFilter, (g + 1) * blocksPerFilter) and the words [g * wordsPerFilter, (g + 1) * wordsPerFilter).
+		- Bitset: bit ids[value] is set if the value occurs in the group, exact
+		- Bloom: BLOOM_HASHES bits per value, may report values that do not occur in the group
+*/
+template <typename D>
+struct membershipFilter {
+	FilterKind kind = FilterKind::None;
+	size_t blocksPerFilter = FILTER_BLOCKS;
+	size_t wordsPerFilter = 0;
+	std::vector<uint64_t> words;
+	std::unordered_map<D, uint32_t> ids;
+};
+
 template <typename D, size_t SIZE>
 struct compressedData {
 	std::unordered_map<D, std::bitset<SIZE>> dictionary;
     std::vector<std::bitset<SIZE>> compressed;
     std::vector<std::pair<D, D>> bounds;
+	// Optional, one per block (see compress)
+	std::vector<blockAggregate> aggregates;
+	// Optional (see build_filter)
+	membershipFilter<D> filter;
 };
 
 class IHuffmanNode
@@ -80,91 +139,153 @@ size_t tree_depth(const IHuffmanNode* node, size_t depth = 0) {
 	}
 }
 
-template <typename D, std::size_t B>
+/**
+	Rows per chunk when counting frequencies and looking up codes, blocks per chunk when encoding.
+	Chunks only depend on the column, so the result is the same however many threads work on them.
+*/
+const size_t COMPRESS_GRAIN = size_t(1) << 16;
+const size_t ENCODE_GRAIN = size_t(1) << 12;
+
+/**
+	Runs fn(first, last) over [0, size) on the calling thread. compress() takes any runner with this signature,
+	Pool::runner() spreads the chunks over a thread pool.
+*/
+struct sequential {
+	template <typename F>
+	void operator()(size_t size, size_t grain, F fn) const {
+		if (size > 0) {
+			fn(0, size);
+		}
+	}
+};
+
+/**
+	Compresses a column in four steps, all but the third split into chunks for the runner:
+		1. Frequencies, one partial hash table per chunk of rows, merged
+		2. Tree from the leaves in (frequency, value) order, ties broken by creation order: the codes do not depend on
+		   the iteration order of the hash tables
+		3. Block boundaries, a sequential pass adding the cached code lengths of the rows
+		4. Blocks, bounds and pre-aggregates, each chunk of blocks encoded on its own
+*/
+template <typename D, std::size_t B, typename R>
 std::tuple<	std::unordered_map<D, std::bitset<B>>,
     std::vector<std::bitset<B>>,
     std::vector<std::pair<D, D>>>
-compress(const std::vector<D> &column) {
-	auto compare = [](const IHuffmanNode * left, const IHuffmanNode * right) {
-		return left->frequency > right->frequency;
-	};
+compress(const std::vector<D> &column, std::vector<blockAggregate> *aggregates, R runner) {
+	if (column.empty()) {
+		return {};
+	}
 
 	// Calculate unique frequencies
-	std::unordered_map<D, size_t> frequencies;
-	for (auto cell : column)
-	{
-		++frequencies[cell];
+	std::vector<std::unordered_map<D, size_t>> partials((column.size() + COMPRESS_GRAIN - 1) / COMPRESS_GRAIN);
+	runner(column.size(), COMPRESS_GRAIN, [&](size_t first, size_t last) {
+		auto &frequencies = partials[first / COMPRESS_GRAIN];
+		for (size_t i = first; i < last; ++i) {
+			++frequencies[column[i]];
+		}
+	});
+	auto frequencies = std::move(partials[0]);
+	for (size_t p = 1; p < partials.size(); ++p) {
+		for (const auto &[value, count] : partials[p]) {
+			frequencies[value] += count;
+		}
 	}
-
-	// Insert all leafs in Huffman Tree
-	std::priority_queue<IHuffmanNode*, std::vector<IHuffmanNode*>, decltype(compare)> minHeap(compare);
-	for (auto const& [key, value] : frequencies)
-	{
-		minHeap.emplace(new LeafHuffmanNode<D>(value, key));
+	std::vector<std::pair<size_t, D>> leaves;
+	leaves.reserve(frequencies.size());
+	for (const auto &[value, count] : frequencies) {
+		leaves.emplace_back(count, value);
 	}
+	std::sort(leaves.begin(), leaves.end());
 
 	// Build Huffman Tree
-	while (minHeap.size() != 1)
+	using node = std::tuple<size_t, size_t, IHuffmanNode*>;
+	std::priority_queue<node, std::vector<node>, std::greater<node>> minHeap;
+	size_t sequence = 0;
+	for (const auto &[count, value] : leaves) {
+		minHeap.emplace(count, sequence++, new LeafHuffmanNode<D>(count, value));
+	}
+	while (minHeap.size() > 1)
 	{
-		auto *left = minHeap.top();
+		auto *left = std::get<2>(minHeap.top());
 		minHeap.pop();
-		auto *right = minHeap.top();
+		auto *right = std::get<2>(minHeap.top());
 		minHeap.pop();
 
-		minHeap.emplace(new InternalHuffmanNode<D>(left, right));
+		auto *parent = new InternalHuffmanNode<D>(left, right);
+		minHeap.emplace(parent->frequency, sequence++, parent);
 	}
 
 	// Build dictionary
 	std::unordered_map<D, std::bitset<B>> dictionary;
 	std::bitset<B> prefix;
-	buildCodes<D>(minHeap.top(), prefix, dictionary);
-
-	// Compress Attribute Vector
-	std::vector<std::bitset<B>> attributeVector;
-	std::vector<std::pair<D, D>> boundsAttributeVector;
-	int bitsetLength = 0;
-	int codeLength;
-	std::bitset<B> currentBitset;
-	std::pair<D, D> bounds;
-	bool pushed = false;
-	bool firstRun = true;
-	for (int i = 0; i < column.size(); ++i)
-	{
-		pushed = false;
-		std::bitset<B> code = dictionary[column[i]];
-		codeLength = getCodeLength(code);
-		if (bitsetLength + getCodeLength(code) > B) {
+	buildCodes<D>(std::get<2>(minHeap.top()), prefix, dictionary);
+
+	// Symbol of every row, codes and their lengths per symbol
+	std::unordered_map<D, uint32_t> symbols(leaves.size());
+	std::vector<std::bitset<B>> codes;
+	std::vector<int> codeLengths;
+	for (const auto &[count, value] : leaves) {
+		symbols[value] = codes.size();
+		codes.push_back(dictionary[value]);
+		codeLengths.push_back(getCodeLength(codes.back()));
+	}
+	std::vector<uint32_t> rowSymbols(column.size());
+	runner(column.size(), COMPRESS_GRAIN, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			rowSymbols[i] = symbols.find(column[i])->second;
+		}
+	});
+
+	// A block ends before the first code that does not fit anymore
+	std::vector<size_t> blockStarts;
+	size_t bitsetLength = 0;
+	for (size_t i = 0; i < column.size(); ++i) {
+		size_t codeLength = codeLengths[rowSymbols[i]];
+		if (i == 0 || bitsetLength + codeLength > B) {
+			blockStarts.push_back(i);
 			bitsetLength = 0;
-			//std::cout << "Bounds" << bounds.first << "   " << bounds.second << '\n';
-			boundsAttributeVector.push_back(bounds);
-			attributeVector.push_back(currentBitset);
-			currentBitset.reset();
-			pushed = true;
-			firstRun = true;
-		}
-		code >>= bitsetLength; //shift
-		currentBitset |= code; //bitwise or
+		}
 		bitsetLength += codeLength;
-		// save min and max value to bounds
-		if (firstRun) {
-			bounds.first = column[i];
-			bounds.second = column[i];
-			//std::cout << "Bounds" << bounds.first << "   " << bounds.second << '\n';
-		} else {
-			bounds.first = std::min(bounds.first, column[i]);
-			bounds.second = std::max(bounds.second, column[i]);
-			//std::cout << "Bounds" << bounds.first << "   " << bounds.second << '\n';
-		}
-		firstRun = false;
-	}
-	if (!pushed) {
-		//std::cout << "Bounds" << bounds.first << "   " << bounds.second << '\n';
-		boundsAttributeVector.push_back(bounds);
-		attributeVector.push_back(currentBitset);
+	}
+	blockStarts.push_back(column.size());
+
+	// Compress Attribute Vector
+	size_t blocks = blockStarts.size() - 1;
+	std::vector<std::bitset<B>> attributeVector(blocks);
+	std::vector<std::pair<D, D>> boundsAttributeVector(blocks);
+	std::vector<blockAggregate> blockAggregates(aggregates ? blocks : 0);
+	runner(blocks, ENCODE_GRAIN, [&](size_t first, size_t last) {
+		for (size_t b = first; b < last; ++b) {
+			std::bitset<B> currentBitset;
+			int length = 0;
+			std::pair<D, D> bounds(column[blockStarts[b]], column[blockStarts[b]]);
+			for (size_t i = blockStarts[b]; i < blockStarts[b + 1]; ++i) {
+				currentBitset |= codes[rowSymbols[i]] >> length;
+				length += codeLengths[rowSymbols[i]];
+				bounds.first = std::min(bounds.first, column[i]);
+				bounds.second = std::max(bounds.second, column[i]);
+				if (aggregates) {
+					blockAggregates[b].add(column[i]);
+				}
+			}
+			attributeVector[b] = currentBitset;
+			boundsAttributeVector[b] = bounds;
+		}
+	});
+	if (aggregates) {
+		aggregates->insert(aggregates->end(), blockAggregates.begin(), blockAggregates.end());
 	}
 	return std::tuple(dictionary, attributeVector, boundsAttributeVector);
 }
 
+template <typename D, std::size_t B>
+std::tuple<	std::unordered_map<D, std::bitset<B>>,
+    std::vector<std::bitset<B>>,
+    std::vector<std::pair<D, D>>>
+compress(const std::vector<D> &column, std::vector<blockAggregate> *aggregates = nullptr) {
+	return compress<D, B>(column, aggregates, sequential());
+}
+
 
 template <typename D, std::size_t B>
 std::vector<D> decompress(std::pair<std::unordered_map<D, std::bitset<B>>, std::vector<std::bitset<B>>> &compressed) {
@@ -209,9 +330,11 @@ std::unordered_map<std::bitset<B>, D> getReverseDictionary(std::unordered_map<D,
 	return reverseDictionary;
 }
 
+/**
+	Appends the values of one block to decompressed, which can be a reused buffer.
+*/
 template <typename D, std::size_t B>
-std::vector<D> decompressBlock(std::bitset<B> block, std::unordered_map<std::bitset<B>, D> reverseDictionary) {
-	std::vector<D> decompressed;
+void decompressBlock(std::bitset<B> block, const std::unordered_map<std::bitset<B>, D> &reverseDictionary, std::vector<D> &decompressed) {
 	std::bitset<B> mask;
 	size_t shift = 0;
 	for (size_t i = 0; i < block.size(); ++i) {
@@ -220,17 +343,214 @@ std::vector<D> decompressBlock(std::bitset<B> block, std::unordered_map<std::bit
 		if (search.none() && !block.none()) {
 			continue;
 		}
-		if (reverseDictionary.find(search) != reverseDictionary.end()) {
+		auto it = reverseDictionary.find(search);
+		if (it != reverseDictionary.end()) {
 			shift = i + 1;
 			mask.reset();
-			decompressed.push_back(reverseDictionary[search]);
+			decompressed.push_back(it->second);
 		}
 	}
+}
+
+template <typename D, std::size_t B>
+std::vector<D> decompressBlock(std::bitset<B> block, const std::unordered_map<std::bitset<B>, D> &reverseDictionary) {
+	std::vector<D> decompressed;
+	decompressBlock(block, reverseDictionary, decompressed);
 	return decompressed;
 }
 
 
 
+/**
+	How a block with the given bounds relates to the range [from, to).
+*/
+enum class Coverage {
+	None,
+	Partial,
+	Full,
+};
+
+template <typename D>
+Coverage block_coverage(const std::pair<D, D> &bound, const std::optional<D> &from, const std::optional<D> &to) {
+	if ((to && !(bound.first < *to)) || (from && bound.second < *from)) {
+		return Coverage::None;
+	}
+	if ((!from || !(bound.first < *from)) && (!to || bound.second < *to)) {
+		return Coverage::Full;
+	}
+	return Coverage::Partial;
+}
+
+/**
+	Calls fn(value) for every value in [from, to). Blocks outside the range are skipped, blocks inside the range
+	are handed to full(block) and only decoded if full returns false (no pre-aggregates).
+*/
+template <typename D, std::size_t SIZE, typename F, typename G>
+void for_each_in_range(const compressedData<D, SIZE> &column, const std::optional<D> &from, const std::optional<D> &to, F fn, G full) {
+	std::unordered_map<std::bitset<SIZE>, D> reverseDictionary = getReverseDictionary(column.dictionary);
+	for (size_t i = 0; i < column.compressed.size(); i++)
+	{
+		auto coverage = block_coverage(column.bounds[i], from, to);
+		if (coverage == Coverage::None || (coverage == Coverage::Full && full(i))) {
+			continue;
+		}
+		for (const auto &value : decompressBlock<D, SIZE>(column.compressed[i], reverseDictionary)) {
+			if (coverage == Coverage::Full || ((!from || !(value < *from)) && (!to || value < *to))) {
+				fn(value);
+			}
+		}
+	}
+}
+
+// ---------------------- FILTERS ------------------ //
+
+inline uint64_t mix(uint64_t h) {
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/**
+	The id (Bitset) or hash (Bloom) of a value, computed once per predicate value and probed against every group.
+	Values without an id are not in the column at all.
+*/
+template <typename D>
+std::optional<uint64_t> filter_key(const membershipFilter<D> &filter, const D &value) {
+	if (filter.kind == FilterKind::Bitset) {
+		auto it = filter.ids.find(value);
+		if (it == filter.ids.end()) {
+			return {};
+		}
+		return it->second;
+	}
+	return mix(std::hash<D>{}(value));
+}
+
+/**
+	Bloom probes use double hashing: bit i of a key is (key + i * step) modulo the filter size (a power of two).
+*/
+template <typename D, typename F>
+void for_each_filter_bit(const membershipFilter<D> &filter, uint64_t key, F fn) {
+	if (filter.kind == FilterKind::Bitset) {
+		fn(key);
+		return;
+	}
+	uint64_t mask = filter.wordsPerFilter * 64 - 1;
+	uint64_t step = (key >> 32) | 1;
+	for (size_t i = 0; i < BLOOM_HASHES; ++i) {
+		fn((key + i * step) & mask);
+	}
+}
+
+/**
+	False only if no value with this key occurs in the group of the block. Without a filter every block may contain it.
+*/
+template <typename D>
+bool may_contain(const membershipFilter<D> &filter, size_t block, uint64_t key) {
+	if (filter.kind == FilterKind::None) {
+		return true;
+	}
+	const uint64_t *words = filter.words.data() + block / filter.blocksPerFilter * filter.wordsPerFilter;
+	bool contained = true;
+	for_each_filter_bit(filter, key, [&](uint64_t bit) {
+		contained &= (words[bit / 64] >> (bit % 64)) & 1;
+	});
+	return contained;
+}
+
+/**
+	Builds the membership filters of a column with one decoding pass. kind None removes them.
+*/
+template <typename D, std::size_t SIZE>
+void build_filter(compressedData<D, SIZE> &column, FilterKind kind, size_t blocksPerFilter = FILTER_BLOCKS) {
+	membershipFilter<D> filter;
+	filter.kind = kind;
+	filter.blocksPerFilter = blocksPerFilter;
+	if (kind == FilterKind::None) {
+		column.filter = filter;
+		return;
+	}
+	// Distinct values of every group
+	std::unordered_map<std::bitset<SIZE>, D> reverseDictionary = getReverseDictionary(column.dictionary);
+	std::vector<std::vector<D>> groups((column.compressed.size() + blocksPerFilter - 1) / blocksPerFilter);
+	size_t maxDistinct = 1;
+	for (size_t g = 0; g < groups.size(); ++g) {
+		std::unordered_set<D> distinct;
+		for (size_t i = g * blocksPerFilter; i < std::min((g + 1) * blocksPerFilter, column.compressed.size()); ++i) {
+			for (const auto &value : decompressBlock<D, SIZE>(column.compressed[i], reverseDictionary)) {
+				distinct.insert(value);
+			}
+		}
+		groups[g].assign(distinct.begin(), distinct.end());
+		maxDistinct = std::max(maxDistinct, groups[g].size());
+	}
+
+	if (kind == FilterKind::Bitset) {
+		uint32_t id = 0;
+		for (const auto &[value, code] : column.dictionary) {
+			filter.ids[value] = id++;
+		}
+		filter.wordsPerFilter = (column.dictionary.size() + 63) / 64;
+	}
+	else {
+		filter.wordsPerFilter = 1;
+		while (filter.wordsPerFilter * 64 < maxDistinct * BLOOM_BITS_PER_VALUE) {
+			filter.wordsPerFilter *= 2;
+		}
+	}
+	filter.words.assign(groups.size() * filter.wordsPerFilter, 0);
+	for (size_t g = 0; g < groups.size(); ++g) {
+		uint64_t *words = filter.words.data() + g * filter.wordsPerFilter;
+		for (const auto &value : groups[g]) {
+			for_each_filter_bit(filter, *filter_key(filter, value), [words](uint64_t bit) {
+				words[bit / 64] |= uint64_t(1) << (bit % 64);
+			});
+		}
+	}
+	column.filter = std::move(filter);
+}
+
+/**
+	Bitset for columns with at most FILTER_MAX_IDS distinct values, Bloom filter otherwise.
+*/
+template <typename D, std::size_t SIZE>
+void build_filter(compressedData<D, SIZE> &column, size_t blocksPerFilter = FILTER_BLOCKS) {
+	build_filter(column, column.dictionary.size() <= FILTER_MAX_IDS ? FilterKind::Bitset : FilterKind::Bloom, blocksPerFilter);
+}
+
+/**
+	Blocks which may hold one of the values: values outside the dictionary are dropped,
+	then a block has to pass the bounds and the filter of its group for at least one value.
+*/
+template <typename D, std::size_t SIZE>
+std::vector<size_t> candidate_blocks(const compressedData<D, SIZE> &column, const std::vector<D> &values) {
+	std::vector<std::pair<D, uint64_t>> keys;
+	for (const auto &value : values) {
+		if (column.dictionary.find(value) == column.dictionary.end()) {
+			continue;
+		}
+		auto key = filter_key(column.filter, value);
+		keys.emplace_back(value, key ? *key : 0);
+	}
+	std::vector<size_t> blocks;
+	if (keys.empty()) {
+		return blocks;
+	}
+	for (size_t i = 0; i < column.compressed.size(); i++)
+	{
+		for (const auto &[value, key] : keys) {
+			if (!(value < column.bounds[i].first) && !(column.bounds[i].second < value) && may_contain(column.filter, i, key)) {
+				blocks.push_back(i);
+				break;
+			}
+		}
+	}
+	return blocks;
+}
+
 // ---------------------- OPS ------------------ //
 
 /**
@@ -261,6 +581,30 @@ size_t count_where_op_equal(std::unordered_map<D, std::bitset<SIZE>> dictionary,
 	return count;
 }
 
+/**
+	Counts all values in the IN-list values. Only the blocks passing bounds and membership filter are decoded.
+*/
+template <typename D, std::size_t SIZE>
+size_t count_where_op_in(const compressedData<D, SIZE> &column, const std::vector<D> &values) {
+	auto blocks = candidate_blocks(column, values);
+	if (blocks.empty()) {
+		return 0;
+	}
+	std::unordered_map<std::bitset<SIZE>, D> reverseDictionary = getReverseDictionary(column.dictionary);
+	std::unordered_set<D> list(values.begin(), values.end());
+	size_t count = 0;
+	for (auto i : blocks) {
+		for (const auto &value : decompressBlock<D, SIZE>(column.compressed[i], reverseDictionary)) {
+			count += list.count(value);
+		}
+	}
+	return count;
+}
+
+template <typename D, std::size_t SIZE>
+size_t count_where_op_equal(const compressedData<D, SIZE> &column, const D &value) {
+	return count_where_op_in(column, std::vector<D>{value});
+}
 
 template <typename D, std::size_t SIZE>
 size_t count_where_op_range(std::unordered_map<D, std::bitset<SIZE>> dictionary,
@@ -344,6 +688,78 @@ D sum_where_op_range(std::unordered_map<D, std::bitset<SIZE>> dictionary,
 	return sum;
 }
 
+/**
+	Count, sum and sum of squares of all values in [from, to). With pre-aggregates only the blocks
+	the range boundaries fall into are decoded, blocks fully inside the range contribute their totals.
+*/
+template <typename D, std::size_t SIZE>
+blockAggregate aggregate_where_op_range(const compressedData<D, SIZE> &column, std::optional<D> from = std::optional<D>(), std::optional<D> to = std::optional<D>()) {
+	blockAggregate result;
+	for_each_in_range(column, from, to, [&result](const D &value) {
+		result.add(value);
+	}, [&column, &result](size_t block) {
+		if (column.aggregates.empty()) {
+			return false;
+		}
+		result.count += column.aggregates[block].count;
+		result.sum += column.aggregates[block].sum;
+		result.sumOfSquares += column.aggregates[block].sumOfSquares;
+		return true;
+	});
+	return result;
+}
+
+template <typename D, std::size_t SIZE>
+double sum_where_op_range(const compressedData<D, SIZE> &column, std::optional<D> from = std::optional<D>(), std::optional<D> to = std::optional<D>()) {
+	return aggregate_where_op_range(column, from, to).sum;
+}
+
+template <typename D, std::size_t SIZE>
+size_t count_where_op_range(const compressedData<D, SIZE> &column, std::optional<D> from = std::optional<D>(), std::optional<D> to = std::optional<D>()) {
+	return aggregate_where_op_range(column, from, to).count;
+}
+
+/**
+	Average of all values. Without decoding a single block if the column has pre-aggregates.
+*/
+template <typename D, std::size_t SIZE>
+double avg_op(const compressedData<D, SIZE> &column) {
+	auto result = aggregate_where_op_range(column);
+	return result.count == 0 ? 0 : result.sum / result.count;
+}
+
+/**
+	Population variance of all values in [from, to), from the sum of squares.
+*/
+template <typename D, std::size_t SIZE>
+double variance_where_op_range(const compressedData<D, SIZE> &column, std::optional<D> from = std::optional<D>(), std::optional<D> to = std::optional<D>()) {
+	auto result = aggregate_where_op_range(column, from, to);
+	if (result.count == 0) {
+		return 0;
+	}
+	double mean = result.sum / result.count;
+	return result.sumOfSquares / result.count - mean * mean;
+}
+
+/**
+	DISTINCT from the symbol table: every key of the Huffman dictionary occurs in the column.
+*/
+template <typename D, std::size_t SIZE>
+std::vector<D> distinct_op(const compressedData<D, SIZE> &column) {
+	std::vector<D> result;
+	result.reserve(column.dictionary.size());
+	for (const auto &[value, code] : column.dictionary) {
+		result.push_back(value);
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+template <typename D, std::size_t SIZE>
+size_t count_distinct_op(const compressedData<D, SIZE> &column) {
+	return column.dictionary.size();
+}
+
 template <typename D, std::size_t SIZE>
 float avg_op(std::unordered_map<D, std::bitset<SIZE>> dictionary,
              std::vector<std::bitset<SIZE>> compressed) {
@@ -418,16 +834,16 @@ std::vector<size_t> indexes_where_range_op(std::unordered_map<D, std::bitset<SIZ
 
 // ---------------------- BENCHMARK ------------------ //
 
-template <typename D>
-Benchmark::CompressionResult benchmark(const std::vector<D> &column, int runs, int warmup, bool clearCache) {
+template <typename D, typename R = sequential>
+Benchmark::CompressionResult benchmark(const std::vector<D> &column, int runs, int warmup, bool clearCache, R runner = R()) {
 	std::cout << "Huffman - Compressing column" << std::endl;
-	auto compressedColumn = compress<D, 64>(column);
+	auto compressedColumn = compress<D, 64>(column, nullptr, runner);
 	auto compressedPair = std::make_pair(std::get<0>(compressedColumn), std::get<1>(compressedColumn));
 	std::cout << "Huffman - Decompressing column" << std::endl;
 	assert(column == decompress(compressedPair));
 	// std::tuple<std::unordered_map<D, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<D, D>>>
-	std::function<std::tuple<std::unordered_map<D, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<D, D>>> ()> compressFunction = [&column]() {
-		return compress<D, 64>(column);
+	std::function<std::tuple<std::unordered_map<D, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<D, D>>> ()> compressFunction = [&column, runner]() {
+		return compress<D, 64>(column, nullptr, runner);
 	};
 	std::function<std::vector<D> ()> decompressFunction = [&compressedPair]() {
 		return decompress(compressedPair);
@@ -459,15 +875,16 @@ Benchmark::CompressionResult benchmark(const std::vector<D> &column, int runs, i
 	return Benchmark::CompressionResult(compressRuntimes, decompressRuntimes, cSize, uSize);
 }
 
-Benchmark::CompressionResult benchmark(const std::vector<std::string> &column, int runs, int warmup, bool clearCache) {
+template <typename R = sequential>
+Benchmark::CompressionResult benchmark(const std::vector<std::string> &column, int runs, int warmup, bool clearCache, R runner = R()) {
 	std::cout << "Huffman - Compressing column" << std::endl;
-	auto compressedColumn = compress<std::string, 64>(column);
+	auto compressedColumn = compress<std::string, 64>(column, nullptr, runner);
 	auto compressedPair = std::make_pair(std::get<0>(compressedColumn), std::get<1>(compressedColumn));
 	std::cout << "Huffman - Decompressing column" << std::endl;
 	assert(column == decompress(compressedPair));
 	// std::tuple<std::unordered_map<std::string, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<std::string, std::string>>>
-	std::function<std::tuple<std::unordered_map<std::string, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<std::string, std::string>>> ()> compressFunction = [&column]() {
-		return compress<std::string, 64>(column);
+	std::function<std::tuple<std::unordered_map<std::string, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<std::string, std::string>>> ()> compressFunction = [&column, runner]() {
+		return compress<std::string, 64>(column, nullptr, runner);
 	};
 	std::function<std::vector<std::string> ()> decompressFunction = [&compressedPair]() {
 		return decompress(compressedPair);
@@ -512,14 +929,14 @@ Benchmark::CompressionResult benchmark(const std::vector<std::string> &column, i
 
 /**
 	D == Dictionary type
-	C == Compressed type
 	R == OP return type
+	The column is passed by reference, so the timed runs measure the op and not a copy of the column.
 */
 template <typename D, typename R>
-std::vector<size_t> benchmark_op_with_dtype(compressedData<D, 64> &compressedColumn,
+std::vector<size_t> benchmark_op_with_dtype(const compressedData<D, 64> &compressedColumn,
 	int runs, int warmup, bool clearCache,
-    std::function<R (compressedData<D, 64>)> func) {
-	std::function<R ()> fn = std::bind(func, compressedColumn);
+    std::function<R (const compressedData<D, 64>&)> func) {
+	std::function<R ()> fn = std::bind(func, std::cref(compressedColumn));
 	return Benchmark::benchmark(fn, runs, warmup, clearCache);
 	std::vector<size_t> res;
 	return res;
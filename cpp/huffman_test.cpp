@@ -14,8 +14,10 @@
 #include <bitset>
 #include <algorithm>
 #include "allocator.cpp"
+#include "date.cpp"
 #include "benchmark.cpp"
 #include "huffman.cpp"
+#include "pool.cpp"
 
 int main(int argc, char const *argv[])
 {
@@ -98,6 +100,145 @@ int main(int argc, char const *argv[])
 		size_t count = Huffman::count_where_op_range<std::string, 64>(std::get<0>(compressedColumn), std::get<1>(compressedColumn), std::get<2>(compressedColumn), "1");
 		std::cout << "count " << count << '\n';
 	}
+	{
+		std::vector<std::string> column = {"1996-01-02", "1995-01-03", "1995-01-04", "1995-01-05", "1995-01-03"};
+		std::vector<Date::date16> convertedColumn;
+		for (auto str : column) {
+			convertedColumn.push_back(Date::parse<uint16_t>(str));
+		}
+		auto compressedColumn = Huffman::compress<Date::date16, 64>(convertedColumn);
+		auto compressedPair = std::make_pair(std::get<0>(compressedColumn), std::get<1>(compressedColumn));
+		assert(convertedColumn == Huffman::decompress(compressedPair));
+
+		auto date = Date::parse<uint16_t>("1996-01-02");
+		auto values = Huffman::values_where_range_op<Date::date16, 64>(std::get<0>(compressedColumn), std::get<1>(compressedColumn), std::get<2>(compressedColumn), {}, date);
+		assert(values.size() == 4);
+		size_t count = Huffman::count_where_op_equal<Date::date16, 64>(std::get<0>(compressedColumn), std::get<1>(compressedColumn), std::get<2>(compressedColumn), Date::parse<uint16_t>("1995-01-03"));
+		assert(count == 2);
+	}
+
+	{
+		// Block pre-aggregates
+		std::vector<int> column;
+		for (int i = 0; i < 3000; ++i) {
+			column.push_back(i / 3);
+		}
+		Huffman::compressedData<int, 64> compressedData;
+		auto compressedColumn = Huffman::compress<int, 64>(column, &compressedData.aggregates);
+		compressedData.dictionary = std::get<0>(compressedColumn);
+		compressedData.compressed = std::get<1>(compressedColumn);
+		compressedData.bounds = std::get<2>(compressedColumn);
+		assert(compressedData.aggregates.size() == compressedData.compressed.size());
+		size_t rows = 0;
+		for (const auto &aggregate : compressedData.aggregates) {
+			rows += aggregate.count;
+		}
+		assert(rows == column.size());
+
+		for (auto [from, to] : {std::pair(100, 800), std::pair(0, 1000), std::pair(333, 334)}) {
+			double sum = 0;
+			size_t count = 0;
+			for (auto v : column) {
+				if (v >= from && v < to) {
+					sum += v;
+					++count;
+				}
+			}
+			assert((Huffman::sum_where_op_range<int, 64>(compressedData, from, to) == sum));
+			assert((Huffman::count_where_op_range<int, 64>(compressedData, from, to) == count));
+		}
+		size_t fullBlocks = 0;
+		for (const auto &bound : compressedData.bounds) {
+			fullBlocks += Huffman::block_coverage<int>(bound, 100, 800) == Huffman::Coverage::Full;
+		}
+		assert(fullBlocks > compressedData.bounds.size() / 2);
+
+		assert(Huffman::avg_op(compressedData) == 499.5);
+		Huffman::compressedData<int, 64> withoutAggregates = compressedData;
+		withoutAggregates.aggregates.clear();
+		assert(Huffman::avg_op(withoutAggregates) == 499.5);
+		assert(std::abs(Huffman::variance_where_op_range(compressedData) - Huffman::variance_where_op_range(withoutAggregates)) < 1e-6);
+	}
+
+	{
+		// Membership filters: scattered keys defeat the block bounds, the filters still skip most blocks
+		std::vector<int> keys;
+		std::vector<std::string> clerks;
+		for (int i = 0; i < 20000; ++i) {
+			keys.push_back((i * 7919) % 20000);
+			clerks.push_back("Clerk#" + std::to_string(i % 2 == 0 ? i / 1000 : (i * 31) % 500));
+		}
+		Huffman::compressedData<int, 64> keyData;
+		auto compressedKeys = Huffman::compress<int, 64>(keys);
+		keyData.dictionary = std::get<0>(compressedKeys);
+		keyData.compressed = std::get<1>(compressedKeys);
+		keyData.bounds = std::get<2>(compressedKeys);
+		auto unfilteredBlocks = Huffman::candidate_blocks(keyData, {4242}).size();
+		Huffman::build_filter(keyData);
+		assert(keyData.filter.kind == Huffman::FilterKind::Bloom);
+		assert(Huffman::candidate_blocks(keyData, {4242}).size() < unfilteredBlocks / 4);
+		for (int key : {0, 4242, 19999}) {
+			assert((Huffman::count_where_op_equal<int, 64>(keyData, key) == 1));
+		}
+		assert((Huffman::count_where_op_equal<int, 64>(keyData, 20000) == 0));
+		assert((Huffman::count_where_op_in<int, 64>(keyData, {1, 2, 3, 20000}) == 3));
+
+		Huffman::compressedData<std::string, 64> clerkData;
+		auto compressedClerks = Huffman::compress<std::string, 64>(clerks);
+		clerkData.dictionary = std::get<0>(compressedClerks);
+		clerkData.compressed = std::get<1>(compressedClerks);
+		clerkData.bounds = std::get<2>(compressedClerks);
+		Huffman::build_filter(clerkData);
+		assert(clerkData.filter.kind == Huffman::FilterKind::Bitset);
+		std::vector<std::string> list = {"Clerk#3", "Clerk#17", "Clerk#600"};
+		size_t expected = 0;
+		for (const auto &clerk : clerks) {
+			expected += std::find(list.begin(), list.end(), clerk) != list.end();
+		}
+		assert((Huffman::count_where_op_in<std::string, 64>(clerkData, list) == expected));
+		assert((Huffman::count_where_op_equal<std::string, 64>(clerkData, std::string("Clerk#17")) == (size_t)std::count(clerks.begin(), clerks.end(), "Clerk#17")));
+		assert(Huffman::candidate_blocks(clerkData, {"Clerk#600"}).empty());
+
+		Huffman::build_filter(clerkData, Huffman::FilterKind::Bloom, 16);
+		assert((Huffman::count_where_op_in<std::string, 64>(clerkData, list) == expected));
+		Huffman::build_filter(clerkData, Huffman::FilterKind::None);
+		assert((Huffman::count_where_op_in<std::string, 64>(clerkData, list) == expected));
+
+		// DISTINCT from the symbol table
+		auto distinct = Huffman::distinct_op(clerkData);
+		std::set<std::string> uniques(clerks.begin(), clerks.end());
+		assert(std::equal(distinct.begin(), distinct.end(), uniques.begin(), uniques.end()));
+		assert(Huffman::count_distinct_op(keyData) == 20000);
+	}
+	std::cout << "#### TEST PARALLEL COMPRESSION ####" << std::endl;
+	{
+		// Several chunks of rows and of blocks, many values with equal frequencies
+		std::vector<int> keys;
+		std::vector<std::string> names;
+		for (int i = 0; i < 300000; ++i) {
+			keys.push_back(i % 5 == 0 ? i % 7 : (int)((int64_t)i * 7919 % 20011));
+			names.push_back("Customer#" + std::to_string((i * 31) % 1500));
+		}
+		// Chunks in reverse order, as an unlucky schedule might run them
+		auto reverse = [](size_t size, size_t grain, auto fn) {
+			for (size_t first = (size - 1) / grain * grain; first < size; first -= grain) {
+				fn(first, std::min(size, first + grain));
+			}
+		};
+		std::vector<Huffman::blockAggregate> aggregates;
+		auto sequential = Huffman::compress<int, 64>(keys, &aggregates);
+		auto sequentialPair = std::pair(std::get<0>(sequential), std::get<1>(sequential));
+		assert(Huffman::decompress(sequentialPair) == keys);
+		std::vector<Huffman::blockAggregate> reverseAggregates;
+		assert((Huffman::compress<int, 64>(keys, &reverseAggregates, reverse) == sequential));
+		assert(reverseAggregates.size() == aggregates.size() && reverseAggregates.back().sum == aggregates.back().sum);
+		for (size_t threads : {1, 3}) {
+			Pool::ThreadPool pool(threads);
+			assert((Huffman::compress<int, 64>(keys, nullptr, Pool::runner(pool)) == sequential));
+			assert((Huffman::compress<std::string, 64>(names, nullptr, Pool::runner(pool)) == Huffman::compress<std::string, 64>(names)));
+		}
+		assert((Huffman::compress<int, 64>(std::vector<int>()) == std::tuple<std::unordered_map<int, std::bitset<64>>, std::vector<std::bitset<64>>, std::vector<std::pair<int, int>>>()));
+	}
 
 	return 0;
-}
\ No newline at end of file
+}
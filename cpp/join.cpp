@@ -0,0 +1,143 @@
+#include <stdexcept>
+
+namespace Join
+{
+
+/**
+	A code domain counts as dense if it is at most this many times larger than the build side:
+	the direct-indexed table (one entry per code) then costs about as much as a hash table.
+*/
+const size_t DENSE_FACTOR = 4;
+
+const size_t NONE = std::numeric_limits<size_t>::max();
+
+/**
+	Key columns of several tables encoded against one sorted dictionary: equal values get equal codes in every column,
+	so joins compare codes instead of values.
+*/
+template <typename D, typename C>
+struct sharedColumns {
+	std::vector<D> dictionary;
+	std::vector<std::vector<C>> codes;
+};
+
+/**
+	Matching row pairs, buildRows[i] joins probeRows[i]. Ordered by probe row.
+*/
+struct joinResult {
+	std::vector<size_t> buildRows;
+	std::vector<size_t> probeRows;
+
+	size_t size() const { return probeRows.size(); }
+};
+
+// ---------------------- COMPRESS ------------------ //
+
+/**
+	Encodes all columns with the sorted union of their values as dictionary.
+*/
+template <typename D, typename C>
+sharedColumns<D, C> compress(const std::vector<const std::vector<D> *> &columns) {
+	sharedColumns<D, C> shared;
+	for (const auto *column : columns) {
+		shared.dictionary.insert(shared.dictionary.end(), column->begin(), column->end());
+	}
+	std::sort(shared.dictionary.begin(), shared.dictionary.end());
+	shared.dictionary.erase(std::unique(shared.dictionary.begin(), shared.dictionary.end()), shared.dictionary.end());
+	if (!shared.dictionary.empty() && shared.dictionary.size() - 1 > std::numeric_limits<C>::max()) {
+		throw std::invalid_argument("Shared dictionary does not fit into the code type");
+	}
+
+	std::unordered_map<D, C> lookup(shared.dictionary.size());
+	for (size_t code = 0; code < shared.dictionary.size(); ++code) {
+		lookup[shared.dictionary[code]] = code;
+	}
+	for (const auto *column : columns) {
+		std::vector<C> codes;
+		codes.reserve(column->size());
+		for (const auto &value : *column) {
+			codes.push_back(lookup[value]);
+		}
+		shared.codes.push_back(std::move(codes));
+	}
+	return shared;
+}
+
+// ---------------------- JOINS ------------------ //
+
+/**
+	Chained build side as two integer arrays: head[slot] is the last build row of a slot, next[row] the previous one.
+	Probing walks the chain of the probe code's slot.
+*/
+template <typename C, typename S>
+joinResult probe(const std::vector<C> &buildCodes, const std::vector<C> &probeCodes, const std::vector<size_t> &head,
+                 const std::vector<size_t> &next, S slot) {
+	joinResult result;
+	for (size_t row = 0; row < probeCodes.size(); ++row) {
+		size_t s = slot(probeCodes[row]);
+		if (s == NONE) {
+			continue;
+		}
+		for (size_t build = head[s]; build != NONE; build = next[build]) {
+			if (buildCodes[build] == probeCodes[row]) {
+				result.buildRows.push_back(build);
+				result.probeRows.push_back(row);
+			}
+		}
+	}
+	return result;
+}
+
+/**
+	Join on dense codes: the code is the slot, no hashing and no key comparison beyond the chain.
+*/
+template <typename C>
+joinResult direct_join(const std::vector<C> &buildCodes, const std::vector<C> &probeCodes, size_t domain) {
+	std::vector<size_t> head(domain, NONE);
+	std::vector<size_t> next(buildCodes.size());
+	for (size_t row = 0; row < buildCodes.size(); ++row) {
+		next[row] = head[buildCodes[row]];
+		head[buildCodes[row]] = row;
+	}
+	return probe(buildCodes, probeCodes, head, next, [domain](C code) {
+		return code < domain ? (size_t)code : NONE;
+	});
+}
+
+/**
+	Join on sparse codes: the slot of a code comes from a hash table sized to the build side.
+*/
+template <typename C>
+joinResult hash_join(const std::vector<C> &buildCodes, const std::vector<C> &probeCodes) {
+	std::unordered_map<C, size_t> slots(buildCodes.size());
+	std::vector<size_t> head;
+	std::vector<size_t> next(buildCodes.size());
+	for (size_t row = 0; row < buildCodes.size(); ++row) {
+		auto [it, inserted] = slots.try_emplace(buildCodes[row], head.size());
+		if (inserted) {
+			head.push_back(NONE);
+		}
+		next[row] = head[it->second];
+		head[it->second] = row;
+	}
+	return probe(buildCodes, probeCodes, head, next, [&slots](C code) {
+		auto it = slots.find(code);
+		return it == slots.end() ? NONE : it->second;
+	});
+}
+
+/**
+	Equi-join of two columns of a shared dictionary, direct-indexed if the dictionary is dense
+	relative to the build side, hashed otherwise.
+*/
+template <typename D, typename C>
+joinResult join(const sharedColumns<D, C> &shared, size_t build, size_t probe) {
+	const auto &buildCodes = shared.codes.at(build);
+	const auto &probeCodes = shared.codes.at(probe);
+	if (shared.dictionary.size() <= DENSE_FACTOR * std::max<size_t>(buildCodes.size(), 1)) {
+		return direct_join(buildCodes, probeCodes, shared.dictionary.size());
+	}
+	return hash_join(buildCodes, probeCodes);
+}
+
+} // end namespace Join
@@ -0,0 +1,82 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "join.cpp"
+
+int main(int argc, char const *argv[])
+{
+	// CUSTOMER(CUSTKEY) 1..1000, ORDERS(CUSTKEY) with keys without customer
+	std::vector<int> customers;
+	for (int key = 1; key <= 1000; ++key) {
+		customers.push_back(key);
+	}
+	std::vector<int> orders;
+	for (int i = 0; i < 20000; ++i) {
+		orders.push_back((i * 7919) % 1100 + 1);
+	}
+	std::vector<std::pair<size_t, size_t>> expected;
+	for (size_t o = 0; o < orders.size(); ++o) {
+		for (size_t c = 0; c < customers.size(); ++c) {
+			if (customers[c] == orders[o]) {
+				expected.emplace_back(c, o);
+			}
+		}
+	}
+	auto pairs = [](const Join::joinResult &result) {
+		std::vector<std::pair<size_t, size_t>> rows;
+		for (size_t i = 0; i < result.size(); ++i) {
+			rows.emplace_back(result.buildRows[i], result.probeRows[i]);
+		}
+		return rows;
+	};
+	std::cout << "#### TEST SHARED DICTIONARY ####" << std::endl;
+	{
+		auto shared = Join::compress<int, uint16_t>({&customers, &orders});
+		assert(shared.dictionary.size() == 1100 && shared.codes.size() == 2);
+		assert(shared.dictionary[shared.codes[0][41]] == customers[41]);
+		assert(shared.dictionary[shared.codes[1][41]] == orders[41]);
+
+		bool thrown = false;
+		try {
+			Join::compress<int, uint8_t>({&customers});
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+		auto wide = Join::compress<int, uint64_t>({&customers, &orders});
+		assert(wide.dictionary == shared.dictionary);
+		assert(std::equal(wide.codes[1].begin(), wide.codes[1].end(), shared.codes[1].begin()));
+	}
+	std::cout << "#### TEST JOINS ####" << std::endl;
+	{
+		auto shared = Join::compress<int, uint16_t>({&customers, &orders});
+		assert(pairs(Join::join(shared, 0, 1)) == expected);
+		assert(pairs(Join::direct_join(shared.codes[0], shared.codes[1], shared.dictionary.size())) == expected);
+		assert(pairs(Join::hash_join(shared.codes[0], shared.codes[1])) == expected);
+
+		// Duplicate build keys: every build row matches
+		std::vector<int> build = {5, 7, 5};
+		std::vector<int> probe = {5, 6, 7};
+		auto small = Join::compress<int, uint8_t>({&build, &probe});
+		std::vector<std::pair<size_t, size_t>> expectedSmall = {{2, 0}, {0, 0}, {1, 2}};
+		assert(pairs(Join::direct_join(small.codes[0], small.codes[1], small.dictionary.size())) == expectedSmall);
+		assert(pairs(Join::hash_join(small.codes[0], small.codes[1])) == expectedSmall);
+		// Sparse: far more distinct keys than build rows
+		std::vector<int> few = {3, 900};
+		auto sparse = Join::compress<int, uint16_t>({&few, &orders});
+		auto result = Join::join(sparse, 0, 1);
+		assert(result.size() == (size_t)std::count(orders.begin(), orders.end(), 3) + std::count(orders.begin(), orders.end(), 900));
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <stdexcept>
+
+namespace Kernel
+{
+
+/**
+	Fused filter + aggregate kernels over Dictionary compressed columns. Filters and aggregates are small structs
+	whose type carries the code width and the kind of predicate, run() instantiates one loop per combination:
+	all filters are evaluated and the aggregate is updated in the same pass, without intermediate vectors.
+	Value predicates are translated into the code domain once, before the loop.
+*/
+
+// ---------------------- FILTERS ------------------ //
+
+/**
+	Rows whose code is in [first, second). Equality and value ranges on the sorted dictionary.
+*/
+template <typename C>
+struct codeRange {
+	const std::vector<C> &codes;
+	size_t first;
+	size_t second;
+
+	size_t rows() const { return codes.size(); }
+	bool match(size_t i) const { return codes[i] >= first && codes[i] < second; }
+};
+
+/**
+	Rows whose code is set in bitmap. Any other predicate, evaluated once per dictionary entry.
+*/
+template <typename C>
+struct codeSet {
+	const std::vector<C> &codes;
+	std::vector<uint8_t> bitmap;
+
+	size_t rows() const { return codes.size(); }
+	bool match(size_t i) const { return bitmap[codes[i]]; }
+};
+
+template <typename D, typename C>
+codeRange<C> equal(const std::pair<std::vector<D>, std::vector<C>> &compressed, const D &value) {
+	size_t first = std::lower_bound(compressed.first.begin(), compressed.first.end(), value) - compressed.first.begin();
+	bool found = first < compressed.first.size() && compressed.first[first] == value;
+	return codeRange<C>{compressed.second, first, first + found};
+}
+
+template <typename D, typename C>
+codeRange<C> range(const std::pair<std::vector<D>, std::vector<C>> &compressed, std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = Dictionary::code_range(compressed.first, from, to);
+	return codeRange<C>{compressed.second, first, second};
+}
+
+template <typename D, typename C, typename P>
+codeSet<C> matching(const std::pair<std::vector<D>, std::vector<C>> &compressed, P predicate) {
+	std::vector<uint8_t> bitmap(compressed.first.size());
+	for (size_t code = 0; code < bitmap.size(); ++code) {
+		bitmap[code] = predicate(compressed.first[code]);
+	}
+	return codeSet<C>{compressed.second, std::move(bitmap)};
+}
+
+// ---------------------- AGGREGATES ------------------ //
+
+/**
+	Aggregates get every row with its match flag and update without branching on it.
+	covers(rows) tells whether the aggregate can read all rows of the filters.
+*/
+struct count {
+	size_t value = 0;
+
+	bool covers(size_t rows) const { return true; }
+	void add(size_t i, bool match) { value += match; }
+	size_t result() const { return value; }
+};
+
+/**
+	Sum of a (possibly different) Dictionary compressed column over the matching rows.
+*/
+template <typename D, typename C>
+struct sum {
+	const std::pair<std::vector<D>, std::vector<C>> &compressed;
+	double value = 0;
+
+	bool covers(size_t rows) const { return compressed.second.size() == rows; }
+	void add(size_t i, bool match) { value += match ? (double)compressed.first[compressed.second[i]] : 0.0; }
+	double result() const { return value; }
+};
+
+template <typename D, typename C>
+sum<D, C> sum_of(const std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return sum<D, C>{compressed};
+}
+
+// ---------------------- KERNEL ------------------ //
+
+/**
+	One pass over the rows: the conjunction of all filters (no short circuit, so no branch per filter)
+	feeds the aggregate. All filters and the aggregated column have to cover the same rows.
+*/
+template <typename A, typename F, typename... G>
+auto run(A aggregate, const F &filter, const G &... filters) {
+	size_t rows = filter.rows();
+	if (((filters.rows() != rows) || ...)) {
+		throw std::invalid_argument("Filters over columns of different length");
+	}
+	if (!aggregate.covers(rows)) {
+		throw std::invalid_argument("Aggregate over a column of different length");
+	}
+	for (size_t i = 0; i < rows; ++i) {
+		aggregate.add(i, (filter.match(i) & ... & filters.match(i)));
+	}
+	return aggregate.result();
+}
+
+template <typename F, typename... G>
+size_t count_where(const F &filter, const G &... filters) {
+	return run(count(), filter, filters...);
+}
+
+template <typename D, typename C, typename F, typename... G>
+double sum_where(const std::pair<std::vector<D>, std::vector<C>> &column, const F &filter, const G &... filters) {
+	return run(sum_of(column), filter, filters...);
+}
+
+} // end namespace Kernel
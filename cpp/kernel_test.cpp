@@ -0,0 +1,78 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "kernel.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::vector<std::string> status;
+	std::vector<int> price;
+	std::vector<int> day;
+	for (int i = 0; i < 10000; ++i) {
+		status.push_back(i % 3 == 0 ? "F" : (i % 3 == 1 ? "O" : "P"));
+		price.push_back((i * 7919) % 1000);
+		day.push_back(i / 10);
+	}
+	auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+	auto compressedPrice = Dictionary::compress<int, uint16_t>(price);
+	auto compressedDay = Dictionary::compress<int, uint32_t>(day);
+	std::cout << "#### TEST SINGLE FILTER ####" << std::endl;
+	{
+		std::function<bool (std::string)> isOpen = [](std::string v) { return v == "O"; };
+		assert(Kernel::count_where(Kernel::equal(compressedStatus, std::string("O"))) == Dictionary::count_where_op(compressedStatus, isOpen));
+		assert(Kernel::count_where(Kernel::equal(compressedStatus, std::string("X"))) == 0);
+		assert(Kernel::count_where(Kernel::matching(compressedStatus, [](const std::string &v) { return v != "F"; })) == 6666);
+
+		double expected = 0;
+		for (auto v : price) {
+			expected += v < 250 ? v : 0;
+		}
+		assert(Kernel::sum_where(compressedPrice, Kernel::range<int, uint16_t>(compressedPrice, {}, 250)) == expected);
+	}
+	std::cout << "#### TEST CONJUNCTION ####" << std::endl;
+	{
+		// SUM(price) WHERE status = 'O' AND day >= 200 AND day < 700 AND price is even
+		size_t expectedCount = 0;
+		double expectedSum = 0;
+		for (size_t i = 0; i < status.size(); ++i) {
+			if (status[i] == "O" && day[i] >= 200 && day[i] < 700 && price[i] % 2 == 0) {
+				++expectedCount;
+				expectedSum += price[i];
+			}
+		}
+		auto open = Kernel::equal(compressedStatus, std::string("O"));
+		auto days = Kernel::range<int, uint32_t>(compressedDay, 200, 700);
+		auto even = Kernel::matching(compressedPrice, [](int v) { return v % 2 == 0; });
+		assert(Kernel::count_where(open, days, even) == expectedCount);
+		assert(Kernel::sum_where(compressedPrice, open, days, even) == expectedSum);
+
+		std::vector<int> shortColumn = {1, 2};
+		auto compressedShort = Dictionary::compress<int, uint8_t>(shortColumn);
+		bool thrown = false;
+		try {
+			Kernel::count_where(open, Kernel::equal(compressedShort, 1));
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+		thrown = false;
+		try {
+			Kernel::sum_where(compressedShort, open);
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	return 0;
+}
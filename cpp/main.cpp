@@ -1,7 +1,6 @@
 #include <vector>
 #include <unordered_map>
 #include <map>
-#include <set>
 #include <string>
 #include <chrono>
 #include <iostream>
@@ -15,127 +14,146 @@
 #include <stdexcept>
 #include <iomanip>
 #include <sstream>
+#include <numeric>
 #include "allocator.cpp"
+#include "date.cpp"
 #include "csv.h"
 #include "benchmark.cpp"
 #include "dictionary.cpp"
+#include "pattern.cpp"
+#include "bitmapindex.cpp"
+#include "cascade.cpp"
+#include "blocklocal.cpp"
 #include "huffman.cpp"
+#include "fsst.cpp"
+#include "statistics.cpp"
+#include "storage.cpp"
+#include "schema.cpp"
+#include "rowgroup.cpp"
+#include "query.cpp"
+#include "batch.cpp"
+#include "kernel.cpp"
+#include "join.cpp"
+#include "sort.cpp"
+#include "cache.cpp"
+#include "shared.cpp"
+#include "pool.cpp"
+#include "morsel.cpp"
 
-template <typename C>
-std::pair<Benchmark::CompressionResult, Benchmark::OpResult> dictionaryBenchmarkColumn(int i, std::vector<std::string> &column, std::vector<std::string> &header,
-																					   int runs, int warmup, bool clearCache, bool compress, bool op)
+/**
+	Operation benchmarks of the ORDERS queries, picked by column name and value type.
+	The column is compressed with its prebuilt dictionary (see Dictionary::build_dictionary).
+*/
+template <typename D, typename C>
+Benchmark::OpResult dictionaryBenchmarkOps(const std::string &name, const std::vector<D> &column, const std::vector<D> &dictionary,
+										   int runs, int warmup, bool clearCache, Pool::ThreadPool &pool)
 {
-	std::cout << "Dictionary - Benchmarking column (" << i + 1 << "/" << header.size() << "): " << header[i] << std::endl;
-	Benchmark::CompressionResult compressionResult;
 	Benchmark::OpResult opResult;
-	if (i == 0 || i == 1 || i == 7)
+	auto compressedColumn = Dictionary::compress<D, C>(column, dictionary);
+	if constexpr (std::is_same_v<D, int32_t>)
 	{
-		// Column to int
-		std::vector<int> convertedColumn;
-		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), [](const std::string &str) { return std::stoi(str); });
-		if (compress)
-		{
-			compressionResult = Dictionary::benchmark_with_dtype<int, C>(convertedColumn, runs, warmup, clearCache);
-		}
-		if (op)
+		if (name == "SHIPPRIORITY")
 		{
-			auto compressedColumn = Dictionary::compress<int, C>(convertedColumn);
-			if (i == 7)
 			{
-				// SHIPPRIORITY
-				{
-					auto func = [](std::pair<std::vector<int>, std::vector<C>> &col) -> size_t {
-						return Dictionary::sum_op(col);
-					};
-					auto runtimes = Dictionary::benchmark_op_with_dtype<int, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
-					opResult.aggregateRuntimes.push_back(runtimes);
-					opResult.aggregateNames.push_back("sum");
-				}
+				auto func = [](std::pair<std::vector<int32_t>, std::vector<C>> &col) -> size_t {
+					return Dictionary::sum_op(col);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<int32_t, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("sum");
 			}
 		}
 	}
-	else if (i == 4)
+	else if constexpr (std::is_same_v<D, Date::date16>)
 	{
-		// Column to std::time_t
-		// ORDERDATE
-		std::vector<std::time_t> convertedColumn;
-		auto transform_fn = [](const std::string &str) {
-			std::tm t = {};
-			std::istringstream ss(str);
-			ss >> std::get_time(&t, "%Y-%m-%d");
-			if (ss.fail())
-			{
-				throw std::invalid_argument("Cannot convert " + str + " to time");
-			}
-			return std::mktime(&t);
-		};
-		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), transform_fn);
-		if (compress)
-		{
-			compressionResult = Dictionary::benchmark_with_dtype<std::time_t, C>(convertedColumn, runs, warmup, clearCache);
-		}
-		if (op)
+		if (name == "ORDERDATE")
 		{
-			auto compressedColumn = Dictionary::compress<std::time_t, C>(convertedColumn);
-			{
-				// 1996-01-02
-				std::tm date;
-				date.tm_mon = 0;
-				date.tm_sec = 0;
-				date.tm_min = 0;
-				date.tm_hour = 0;
-				date.tm_wday = 0;
-				date.tm_yday = 0;
-				date.tm_year = 96;
-				date.tm_mday = 2;
-				std::function<bool(std::time_t)> predicate = [&date](std::time_t i) {
-					// 1996-01-02
-					return i < std::mktime(&date);
-				};
-				auto func = [predicate](std::pair<std::vector<std::time_t>, std::vector<C>> &col) -> std::vector<std::time_t> {
+			auto date = Date::parse<uint16_t>("1996-01-02");
+			{
+				std::function<bool(Date::date16)> predicate = [date](Date::date16 i) {
+					return i < date;
+				};
+				auto func = [predicate](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<Date::date16> {
 					return Dictionary::where_view_op(col, predicate);
 				};
-				auto runtimes = Dictionary::benchmark_op_with_dtype<std::time_t, C, std::vector<std::time_t>>(compressedColumn, runs, warmup, clearCache, func);
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<Date::date16>>(compressedColumn, runs, warmup, clearCache, func);
 				opResult.aggregateRuntimes.push_back(runtimes);
 				opResult.aggregateNames.push_back("where_view_less_1996-01-02");
 			}
 			{
-				// 1996-01-02
-				std::tm date;
-				date.tm_mon = 0;
-				date.tm_sec = 0;
-				date.tm_min = 0;
-				date.tm_hour = 0;
-				date.tm_wday = 0;
-				date.tm_yday = 0;
-				date.tm_year = 96;
-				date.tm_mday = 2;
-				std::function<bool(std::time_t)> predicate = [&date](std::time_t i) {
-					// 1996-01-02
-					return i < std::mktime(&date);
-				};
-				auto func = [predicate](std::pair<std::vector<std::time_t>, std::vector<C>> &col) -> std::vector<std::time_t> {
+				std::function<bool(Date::date16)> predicate = [date](Date::date16 i) {
+					return i < date;
+				};
+				auto func = [predicate](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<Date::date16> {
 					return Dictionary::where_copy_op(col, predicate);
 				};
-				auto runtimes = Dictionary::benchmark_op_with_dtype<std::time_t, C, std::vector<std::time_t>>(compressedColumn, runs, warmup, clearCache, func);
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<Date::date16>>(compressedColumn, runs, warmup, clearCache, func);
 				opResult.aggregateRuntimes.push_back(runtimes);
 				opResult.aggregateNames.push_back("where_copy_less_1996-01-02");
 			}
+			{
+				auto func = [date](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_where_op_range<Date::date16, C>(col, {}, date);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_range_less_1996-01-02");
+			}
+			{
+				// Chooses where_view or where_copy from the selectivity in the statistics
+				auto stats = Statistics::compute(compressedColumn);
+				std::function<bool(Date::date16)> predicate = [date](Date::date16 i) {
+					return i < date;
+				};
+				auto func = [predicate, &stats](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<Date::date16> {
+					return Statistics::where_op(col, stats, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<Date::date16>>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("where_stats_less_1996-01-02");
+			}
+			{
+				// Zones whose code range holds no matching date are skipped
+				auto zones = Dictionary::build_zone_map(compressedColumn);
+				std::function<bool(Date::date16)> predicate = [date](Date::date16 i) {
+					return i < date;
+				};
+				auto func = [predicate, &zones](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<Date::date16> {
+					return Dictionary::where_view_op(col, zones, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<Date::date16>>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("where_view_zones_less_1996-01-02");
+				auto countFunc = [predicate, &zones](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_where_op(col, zones, predicate);
+				};
+				runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, size_t>(compressedColumn, runs, warmup, clearCache, countFunc);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_zones_less_1996-01-02");
+			}
+			{
+				// 10 most recent orders, decoded only for the 10 rows
+				auto func = [](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<Date::date16> {
+					return Dictionary::partial_decompress(col, Sort::top_k(col, 10));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<Date::date16>>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("top_10_most_recent");
+			}
+			{
+				auto func = [](std::pair<std::vector<Date::date16>, std::vector<C>> &col) -> std::vector<size_t> {
+					return Sort::order_by(col);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<Date::date16, C, std::vector<size_t>>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("order_by");
+			}
 		}
 	}
-	else if (i == 3)
+	else if constexpr (std::is_same_v<D, float>)
 	{
-		// Column to float
-		// TOTALPRICE
-		std::vector<float> convertedColumn;
-		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), [](const std::string &str) { return std::stof(str); });
-		if (compress)
-		{
-			compressionResult = Dictionary::benchmark_with_dtype<float, C>(convertedColumn, runs, warmup, clearCache);
-		}
-		if (op)
+		if (name == "TOTALPRICE")
 		{
-			auto compressedColumn = Dictionary::compress<float, C>(convertedColumn);
 			{
 				auto func = [](std::pair<std::vector<float>, std::vector<C>> &col) -> float {
 					return Dictionary::min_op(col);
@@ -160,6 +178,15 @@ std::pair<Benchmark::CompressionResult, Benchmark::OpResult> dictionaryBenchmark
 				opResult.aggregateRuntimes.push_back(runtimes);
 				opResult.aggregateNames.push_back("avg");
 			}
+			{
+				auto stats = Statistics::compute(compressedColumn);
+				auto func = [&stats](std::pair<std::vector<float>, std::vector<C>> &col) -> float {
+					return Statistics::avg_op(stats);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, float>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("avg_stats");
+			}
 			{
 				auto func = [](std::pair<std::vector<float>, std::vector<C>> &col) -> float {
 					return Dictionary::sum_op(col);
@@ -168,45 +195,214 @@ std::pair<Benchmark::CompressionResult, Benchmark::OpResult> dictionaryBenchmark
 				opResult.aggregateRuntimes.push_back(runtimes);
 				opResult.aggregateNames.push_back("sum");
 			}
+			{
+				// Morsels of the attribute vector on the nodes of the pool, no sorted copy
+				auto placed = Morsel::place(pool, compressedColumn);
+				auto func = [&pool, &placed](std::pair<std::vector<float>, std::vector<C>> &col) -> float {
+					return Morsel::sum_op(pool, placed);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, float>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("sum_morsel");
+			}
+			{
+				// Full-column temporary: copy of all matching codes, then sum
+				std::function<bool(float)> predicate = [](float v) {
+					return v < 99498.77f;
+				};
+				auto func = [predicate](std::pair<std::vector<float>, std::vector<C>> &col) -> size_t {
+					return Dictionary::sum_where_copy_op(col, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("sum_where_copy_less_99498.77");
+			}
+			{
+				// Batch at a time: decode, filter and sum BATCH_SIZE values in one reused buffer
+				auto func = [](std::pair<std::vector<float>, std::vector<C>> &col) -> double {
+					Batch::DictionaryScan<float, C> scan(col);
+					return Batch::sum_where(scan, [](float v) { return v < 99498.77f; });
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, double>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("sum_where_batch_less_99498.77");
+			}
+			{
+				// Code range filter and sum fused into one loop
+				auto func = [](std::pair<std::vector<float>, std::vector<C>> &col) -> double {
+					return Kernel::sum_where(col, Kernel::range<float, C>(col, {}, 99498.77f));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, double>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("sum_where_fused_less_99498.77");
+			}
+			{
+				auto func = [](std::pair<std::vector<float>, std::vector<C>> &col) -> std::vector<float> {
+					return Dictionary::partial_decompress(col, Sort::top_k(col, 100));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, std::vector<float>>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("top_100");
+			}
+			{
+				// min, max, avg, sum and the filtered sum above in one pass over the codes
+				std::vector<Shared::predicate<float>> predicates = {{}, [](float v) { return v < 99498.77f; }};
+				auto func = [&predicates](std::pair<std::vector<float>, std::vector<C>> &col) -> double {
+					auto answers = Shared::scan(col, predicates);
+					return answers[0].sum + answers[1].sum;
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<float, C, double>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("shared_scan_all_aggregates");
+			}
 		}
 	}
-	else
+	else if constexpr (std::is_same_v<D, std::string>)
 	{
-		// Column as string
-		if (compress)
+		if (name == "ORDERSTATUS")
 		{
-			compressionResult = Dictionary::benchmark_with_dtype<C>(column, runs, warmup, clearCache);
+			{
+				std::function<bool(std::string)> predicate = [](std::string i) {
+					return i == "O";
+				};
+				auto func = [predicate](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_where_op(col, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_O");
+			}
+			{
+				std::function<bool(std::string)> predicate = [](std::string i) {
+					return i == "P";
+				};
+				auto func = [predicate](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_where_op(col, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_P");
+			}
+			{
+				auto stats = Statistics::compute(compressedColumn);
+				auto func = [&stats](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Statistics::count_where_op_equal(col, stats, std::string("O"));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_O_stats");
+			}
+			{
+				auto func = [](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Kernel::count_where(Kernel::equal(col, std::string("O")));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_O_fused");
+			}
+			{
+				std::function<bool(std::string)> predicate = [](std::string i) {
+					return i == "O";
+				};
+				auto func = [&pool, predicate](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Morsel::count_where_op(pool, col, predicate);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_O_morsel");
+			}
+			{
+				// Repeated dashboard filter: only the first run scans, the others hit the cache
+				Cache::ResultCache cache;
+				auto func = [&cache](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Cache::count_where(cache, "ORDERSTATUS", col, Cache::equal<std::string>("O"));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_equals_O_cached");
+				const auto &stats = cache.getStatistics();
+				std::cout << "Result cache - hits: " << stats.hits << ", misses: " << stats.misses << ", bytes: " << stats.bytes << std::endl;
+			}
+			{
+				auto func = [](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_distinct_op(col);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_distinct");
+			}
 		}
-		if (op)
+		else if (name == "CLERK")
 		{
-			auto compressedColumn = Dictionary::compress<std::string, C>(column);
-			if (i == 2)
 			{
-				// ORDERSTATUS
-				{
-					std::function<bool(std::string)> predicate = [](std::string i) {
-						return i == "O";
-					};
-					auto func = [predicate](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
-						return Dictionary::count_where_op(col, predicate);
-					};
-					auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
-					opResult.aggregateRuntimes.push_back(runtimes);
-					opResult.aggregateNames.push_back("count_where_equals_O");
-				}
-				{
-					std::function<bool(std::string)> predicate = [](std::string i) {
-						return i == "P";
-					};
-					auto func = [predicate](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
-						return Dictionary::count_where_op(col, predicate);
-					};
-					auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
-					opResult.aggregateRuntimes.push_back(runtimes);
-					opResult.aggregateNames.push_back("count_where_equals_P");
+				// The prefix is a code range, found once with two binary searches
+				auto func = [](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Pattern::count_where_op(col, Pattern::prefix(col.first, "Clerk#000000"));
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_prefix_Clerk#000000");
+			}
+			{
+				// COUNT(DISTINCT CLERK) over every 7th row, standing in for the rows selected by a filter on another column
+				std::vector<size_t> rows;
+				for (size_t row = 0; row < compressedColumn.second.size(); row += 7) {
+					rows.push_back(row);
 				}
+				auto func = [&rows](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+					return Dictionary::count_distinct_op(col, rows);
+				};
+				auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_distinct_selected_rows");
 			}
 		}
+		else if (name == "COMMENT")
+		{
+			// TPC-H Q13 filter, searched in the dictionary byte pool
+			auto pool = Pattern::pool(compressedColumn.first);
+			auto func = [&pool](std::pair<std::vector<std::string>, std::vector<C>> &col) -> size_t {
+				return Pattern::count_where_op(col, Pattern::like(col.first, pool, "%special%requests%"));
+			};
+			auto runtimes = Dictionary::benchmark_op_with_dtype<std::string, C, size_t>(compressedColumn, runs, warmup, clearCache, func);
+			opResult.aggregateRuntimes.push_back(runtimes);
+			opResult.aggregateNames.push_back("count_where_like_special_requests");
+		}
+	}
+	return opResult;
+}
+
+template <typename C, typename D>
+std::pair<Benchmark::CompressionResult, Benchmark::OpResult> dictionaryBenchmarkColumn(int i, const std::vector<D> &values, const std::vector<D> &dictionary,
+																					   std::vector<std::string> &header,
+																					   int runs, int warmup, bool clearCache, bool compress, bool op, bool cascade, bool blockLocal,
+																					   Pool::ThreadPool &pool)
+{
+	std::cout << "Dictionary - Benchmarking column (" << i + 1 << "/" << header.size() << "): " << header[i] << std::endl;
+	Benchmark::CompressionResult compressionResult;
+	Benchmark::OpResult opResult;
+	if (compress)
+	{
+		if (cascade)
+		{
+			compressionResult = Cascade::benchmark_with_dtype<D, C>(values, runs, warmup, clearCache);
+		}
+		else if (blockLocal)
+		{
+			compressionResult = BlockLocal::benchmark_with_dtype<D>(values, runs, warmup, clearCache);
+		}
+		else if constexpr (std::is_same_v<D, std::string>)
+		{
+			compressionResult = Dictionary::benchmark_with_dtype<C>(values, runs, warmup, clearCache);
+		}
+		else
+		{
+			compressionResult = Dictionary::benchmark_with_dtype<D, C>(values, runs, warmup, clearCache);
+		}
+	}
+	if (op)
+	{
+		opResult = dictionaryBenchmarkOps<D, C>(header[i], values, dictionary, runs, warmup, clearCache, pool);
 	}
 	return std::pair(compressionResult, opResult);
 }
@@ -246,44 +442,30 @@ std::pair<Benchmark::CompressionResult, Benchmark::OpResult> huffmanBenchmarkCol
 			}
 		}
 	}
-	else if (false && i == 4)
+	else if (i == 4)
 	{
-		// Column to std::time_t
+		// Column to Date::date16
 		// ORDERDATE
-		std::vector<std::time_t> convertedColumn;
-		auto transform_fn = [](const std::string &str) {
-			std::tm t = {};
-			std::istringstream ss(str);
-			ss >> std::get_time(&t, "%Y-%m-%d");
-			if (ss.fail())
-			{
-				throw std::invalid_argument("Cannot convert " + str + " to time");
-			}
-			return std::mktime(&t);
-		};
-		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), transform_fn);
-		// 	if (compress) {
-		// 		compressionResult = Huffman::benchmark_with_dtype<std::time_t, C>(convertedColumn, runs, warmup, clearCache);
-		// 	}
+		std::vector<Date::date16> convertedColumn;
+		convertedColumn.reserve(column.size());
+		std::transform(column.begin(), column.end(), std::back_inserter(convertedColumn), [](const std::string &str) { return Date::parse<uint16_t>(str); });
+		if (compress)
+		{
+			compressionResult = Huffman::benchmark(convertedColumn, runs, warmup, clearCache);
+		}
 		if (op)
 		{
-			auto compressedColumn = Huffman::compress<std::time_t, 64>(convertedColumn);
+			auto compressedColumn = Huffman::compress<Date::date16, 64>(convertedColumn);
+			Huffman::compressedData<Date::date16, 64> compressedData;
+			compressedData.dictionary = std::get<0>(compressedColumn);
+			compressedData.compressed = std::get<1>(compressedColumn);
+			compressedData.bounds = std::get<2>(compressedColumn);
 			{
-				// 1996-01-02
-				std::tm date;
-				date.tm_mon = 0;
-				date.tm_sec = 0;
-				date.tm_min = 0;
-				date.tm_hour = 0;
-				date.tm_wday = 0;
-				date.tm_yday = 0;
-				date.tm_year = 96;
-				date.tm_mday = 2;
-
-				auto func = [date](std::pair<std::vector<std::time_t>, std::vector<C>> &col) -> std::vector<std::time_t> {
-					return Huffman::values_where_range_op(std::get<0>(col), std::get<1>(col), std::get<2>(col), NULL, std::mktime(&date));
+				auto date = Date::parse<uint16_t>("1996-01-02");
+				std::function<std::vector<Date::date16>(const Huffman::compressedData<Date::date16, 64>&)> func = [date](const Huffman::compressedData<Date::date16, 64> &col) {
+					return Huffman::values_where_range_op<Date::date16, 64>(col.dictionary, col.compressed, col.bounds, {}, date);
 				};
-				auto runtimes = Huffman::benchmark_op_with_dtype<std::time_t, C, std::vector<std::time_t>>(compressedColumn, runs, warmup, clearCache, func);
+				auto runtimes = Huffman::benchmark_op_with_dtype<Date::date16, std::vector<Date::date16>>(compressedData, runs, warmup, clearCache, func);
 				opResult.aggregateRuntimes.push_back(runtimes);
 				opResult.aggregateNames.push_back("where_view_less_1996-01-02");
 			}
@@ -369,47 +551,72 @@ std::pair<Benchmark::CompressionResult, Benchmark::OpResult> huffmanBenchmarkCol
 	return std::pair(compressionResult, opResult);
 }
 
-void fullDictionaryBenchmark(std::vector<std::vector<std::string>> &table, std::vector<std::string> &header,
-							 int runs, int warmup, bool clearCache, bool compress, bool op,
-							 std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile)
+/**
+	Runs column(i) for every column as a task of the pool and returns the results in column order.
+	Isolated mode waits for each task before submitting the next one.
+*/
+template <typename R, typename F>
+std::vector<R> benchmarkColumns(Pool::ThreadPool &pool, Pool::Mode mode, size_t columns, F column)
 {
-
-	std::string dataDirectory = "../data/dictionary/";
-
-	std::vector<std::pair<Benchmark::CompressionResult, Benchmark::OpResult>> results;
-	for (int i = 0; i < header.size(); ++i)
+	std::vector<std::future<std::optional<R>>> tasks;
+	std::vector<R> results;
+	for (size_t i = 0; i < columns; ++i)
 	{
-		std::set<std::string> uniques;
-		auto column = table[i];
-		for (auto cell : column)
-		{
-			uniques.emplace(cell);
-		}
-		if (uniques.size() <= std::pow(2, 8))
-		{
-			std::cout << "Dictionary - Compressing column - " << uniques.size() << " = 2^8" << std::endl;
-			results.push_back(dictionaryBenchmarkColumn<uint8_t>(i, column, header, runs, warmup, clearCache, compress, op));
-		}
-		else if (uniques.size() <= std::pow(2, 16))
-		{
-			std::cout << "Dictionary - Compressing column - " << uniques.size() << " = 2^16" << std::endl;
-			results.push_back(dictionaryBenchmarkColumn<uint16_t>(i, column, header, runs, warmup, clearCache, compress, op));
-		}
-		else if (uniques.size() <= std::pow(2, 32))
-		{
-			std::cout << "Dictionary - Compressing column - " << uniques.size() << " = 2^32" << std::endl;
-			results.push_back(dictionaryBenchmarkColumn<uint32_t>(i, column, header, runs, warmup, clearCache, compress, op));
-		}
-		else if (uniques.size() <= std::pow(2, 64))
+		tasks.push_back(pool.submit([&column, i] { return column(i); }));
+		if (mode == Pool::Mode::Isolated)
 		{
-			std::cout << "Dictionary - Compressing column - " << uniques.size() << " = 2^64" << std::endl;
-			results.push_back(dictionaryBenchmarkColumn<uint64_t>(i, column, header, runs, warmup, clearCache, compress, op));
+			tasks.back().wait();
 		}
-		else
+	}
+	for (auto &task : tasks)
+	{
+		if (auto result = pool.wait(task))
 		{
-			std::cout << "Cannot address more than 2^64 uniques" << std::endl;
+			results.push_back(std::move(*result));
 		}
 	}
+	return results;
+}
+
+void fullDictionaryBenchmark(std::vector<Schema::typedColumn> &table, std::vector<std::string> &header,
+							 int runs, int warmup, bool clearCache, bool compress, bool op, bool cascade, bool blockLocal,
+							 std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile,
+							 Pool::ThreadPool &pool, Pool::Mode mode)
+{
+
+	std::string dataDirectory = cascade ? "../data/cascade/" : (blockLocal ? "../data/block_local/" : "../data/dictionary/");
+
+	using ColumnResult = std::pair<Benchmark::CompressionResult, Benchmark::OpResult>;
+	auto results = benchmarkColumns<ColumnResult>(pool, mode, header.size(), [&](int i) -> std::optional<ColumnResult> {
+		// The schema already parsed the column into its value type. Its dictionary is built once: its size picks
+		// the code width, the op benchmarks compress the column with it.
+		return std::visit([&](const auto &values) -> std::optional<ColumnResult> {
+			auto dictionary = Dictionary::build_dictionary(values);
+			size_t uniques = dictionary.size();
+			if (uniques <= std::pow(2, 8))
+			{
+				std::cout << "Dictionary - Compressing column - " << uniques << " = 2^8" << std::endl;
+				return dictionaryBenchmarkColumn<uint8_t>(i, values, dictionary, header, runs, warmup, clearCache, compress, op, cascade, blockLocal, pool);
+			}
+			else if (uniques <= std::pow(2, 16))
+			{
+				std::cout << "Dictionary - Compressing column - " << uniques << " = 2^16" << std::endl;
+				return dictionaryBenchmarkColumn<uint16_t>(i, values, dictionary, header, runs, warmup, clearCache, compress, op, cascade, blockLocal, pool);
+			}
+			else if (uniques <= std::pow(2, 32))
+			{
+				std::cout << "Dictionary - Compressing column - " << uniques << " = 2^32" << std::endl;
+				return dictionaryBenchmarkColumn<uint32_t>(i, values, dictionary, header, runs, warmup, clearCache, compress, op, cascade, blockLocal, pool);
+			}
+			else if (uniques <= std::pow(2, 64))
+			{
+				std::cout << "Dictionary - Compressing column - " << uniques << " = 2^64" << std::endl;
+				return dictionaryBenchmarkColumn<uint64_t>(i, values, dictionary, header, runs, warmup, clearCache, compress, op, cascade, blockLocal, pool);
+			}
+			std::cout << "Cannot address more than 2^64 uniques" << std::endl;
+			return {};
+		}, table[i].values);
+	});
 
 	std::cout << "Dictionary - Finished" << std::endl;
 	if (compress)
@@ -447,58 +654,27 @@ void fullDictionaryBenchmark(std::vector<std::vector<std::string>> &table, std::
 	}
 }
 
-void fullHuffmanBenchmark(std::vector<std::vector<std::string>> &table, std::vector<std::string> &header,
+void fullHuffmanBenchmark(std::vector<Schema::typedColumn> &table, std::vector<std::string> &header,
 						  int runs, int warmup, bool clearCache,
-						  std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile)
+						  std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile,
+						  Pool::ThreadPool &pool, Pool::Mode mode)
 {
 
 	std::string dataDirectory = "../data/huffman/";
 
-	std::vector<Benchmark::CompressionResult> results;
-	for (int i = 0; i < header.size(); ++i)
-	{
-		if (i == 1 || i == 0 || i == 8)
+	auto results = benchmarkColumns<Benchmark::CompressionResult>(pool, mode, header.size(), [&](int i) -> std::optional<Benchmark::CompressionResult> {
+		// Nearly one unique per row, Huffman does not pay off
+		if (header[i] == "ORDERKEY" || header[i] == "CUSTKEY" || header[i] == "COMMENT")
 		{
-			continue;
+			return {};
 		}
 		std::cout << "Huffman - Benchmarking column (" << i + 1 << "/" << header.size() << "): " << header[i] << std::endl;
-		if (i == 0 || i == 1 || i == 7)
-		{
-			// Column to int
-			std::vector<int> convertedColumn;
-			std::transform(table[i].begin(), table[i].end(), std::back_inserter(convertedColumn), [](const std::string &str) { return std::stoi(str); });
-			auto benchmarkResult = Huffman::benchmark(convertedColumn, runs, warmup, clearCache);
-			// TODO: Implement aggregates on huffman
-			// TODO: Run aggregate tests
-			// {
-			// 	where_copy_op
-			// 	std::function<bool (int)> predicate = [](int i) {
-			// 		return i > 5;
-			// 	};
-			// 	auto func = [predicate](std::pair<std::vector<int>, std::vector<C>> &col) -> std::vector<int> {
-			// 		return Dictionary::where_copy_op(col, predicate);
-			// 	};
-			// 	auto runtimes = Dictionary::benchmark_op_with_dtype<int, C, std::vector<int>>(column, 1, 1, false, func);
-			// 	result.aggregateRuntimes.push_back(runtimes);
-			// 	result.aggregateNames.push_back("where_copy_gt5_");
-			// }
-			results.push_back(benchmarkResult);
-		}
-		else if (i == 3)
-		{
-			// Column to float
-			std::vector<float> convertedColumn;
-			std::transform(table[i].begin(), table[i].end(), std::back_inserter(convertedColumn), [](const std::string &str) { return std::stof(str); });
-			auto benchmarkResult = Huffman::benchmark(convertedColumn, runs, warmup, clearCache);
-			results.push_back(benchmarkResult);
-		}
-		else
-		{
-			// Column as string
-			auto benchmarkResult = Huffman::benchmark(table[i], runs, warmup, clearCache);
-			results.push_back(benchmarkResult);
-		}
-	}
+		// TODO: Implement aggregates on huffman
+		// TODO: Run aggregate tests
+		return std::visit([&](const auto &values) {
+			return Huffman::benchmark(values, runs, warmup, clearCache, Pool::runner(pool));
+		}, table[i].values);
+	});
 
 	std::cout << "Huffman - Finished" << std::endl;
 	std::vector<double> cRatios;
@@ -529,7 +705,91 @@ void fullHuffmanBenchmark(std::vector<std::vector<std::string>> &table, std::vec
 	// }
 }
 
-void slidesBenchmark(std::vector<std::vector<std::string>> &table, std::vector<std::string> &header,
+void fullFSSTBenchmark(std::vector<Schema::typedColumn> &table, std::vector<std::string> &tableHeader,
+					   int runs, int warmup, bool clearCache, bool compress, bool op,
+					   std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile)
+{
+
+	std::string dataDirectory = "../data/fsst/";
+
+	// Only STRING columns are compressed, the output files list only those
+	std::vector<std::string> header;
+	std::vector<std::pair<Benchmark::CompressionResult, Benchmark::OpResult>> results;
+	for (int i = 0; i < tableHeader.size(); ++i)
+	{
+		auto *column = std::get_if<std::vector<std::string>>(&table[i].values);
+		if (column == nullptr)
+		{
+			continue;
+		}
+		header.push_back(tableHeader[i]);
+		std::cout << "FSST - Benchmarking column (" << i + 1 << "/" << tableHeader.size() << "): " << tableHeader[i] << std::endl;
+		Benchmark::CompressionResult compressionResult;
+		Benchmark::OpResult opResult;
+		if (compress)
+		{
+			compressionResult = FSST::benchmark(*column, runs, warmup, clearCache);
+		}
+		if (op && tableHeader[i] == "COMMENT")
+		{
+			auto compressedColumn = FSST::compress(*column);
+			{
+				std::function<size_t(const FSST::compressedData &)> func = [](const FSST::compressedData &col) {
+					return FSST::count_where_op_like(col, "furiously%");
+				};
+				auto runtimes = FSST::benchmark_op(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_like_furiously%");
+			}
+			{
+				std::function<size_t(const FSST::compressedData &)> func = [](const FSST::compressedData &col) {
+					return FSST::count_where_op_like(col, "%special%requests%");
+				};
+				auto runtimes = FSST::benchmark_op(compressedColumn, runs, warmup, clearCache, func);
+				opResult.aggregateRuntimes.push_back(runtimes);
+				opResult.aggregateNames.push_back("count_where_like_%special%requests%");
+			}
+		}
+		results.push_back(std::pair(compressionResult, opResult));
+	}
+
+	std::cout << "FSST - Finished" << std::endl;
+	if (compress)
+	{
+		std::vector<double> cRatios;
+		std::vector<size_t> cSizes;
+		std::vector<size_t> uSizes;
+		std::vector<std::vector<size_t>> cTimes;
+		std::vector<std::vector<size_t>> dcTimes;
+		for (int i = 0; i < results.size(); ++i)
+		{
+			auto result = results[i].first;
+			cRatios.emplace_back(result.compressionRatio);
+			cSizes.emplace_back(result.compressedSize);
+			uSizes.emplace_back(result.uncompressedSize);
+			cTimes.emplace_back(result.compressionTimes);
+			dcTimes.emplace_back(result.decompressionTimes);
+		}
+		CSV::writeLine<double>(header, cRatios, dataDirectory + cRatioFile);
+		CSV::writeLine<size_t>(header, cSizes, dataDirectory + cSizeFile);
+		CSV::writeLine<size_t>(header, uSizes, dataDirectory + uSizeFile);
+		CSV::writeMultiLine<size_t>(header, cTimes, dataDirectory + cTimesFile);
+		CSV::writeMultiLine<size_t>(header, dcTimes, dataDirectory + dcTimesFile);
+	}
+	if (op)
+	{
+		for (int j = 0; j < results.size(); ++j)
+		{
+			auto result = results[j].second;
+			for (int i = 0; i < result.aggregateRuntimes.size(); ++i)
+			{
+				CSV::writeSingleColumn<size_t>(header[j], result.aggregateRuntimes[i], dataDirectory + "AGG__" + header[j] + "__" + result.aggregateNames[i] + ".csv");
+			}
+		}
+	}
+}
+
+void slidesBenchmark(std::vector<Schema::typedColumn> &table, std::vector<std::string> &header,
 					 int runs, int warmup, bool clearCache,
 					 std::string cRatioFile, std::string cSizeFile, std::string uSizeFile, std::string cTimesFile, std::string dcTimesFile)
 {
@@ -586,12 +846,77 @@ void slidesBenchmark(std::vector<std::vector<std::string>> &table, std::vector<s
 	// 	results.push_back(opResult);
 	// }
 
+	{
+		// TOTALPRICE: with block pre-aggregates only the blocks the range boundary falls into are decoded
+		std::cout << "TOTALPRICE" << std::endl;
+		const auto &convertedColumn = std::get<std::vector<float>>(Schema::column(table, "TOTALPRICE").values);
+		Huffman::compressedData<float, 64> compressedData;
+		auto compressedColumn = Huffman::compress<float, 64>(convertedColumn, &compressedData.aggregates);
+		compressedData.dictionary = std::get<0>(compressedColumn);
+		compressedData.compressed = std::get<1>(compressedColumn);
+		compressedData.bounds = std::get<2>(compressedColumn);
+
+		// 100 %, 80 %: x < 229815.16, 50 %: x < 99498.77
+		std::string columnName = "TOTALPRICE";
+		std::vector<std::pair<std::string, std::optional<float>>> queries = {{"sum_totalprice", {}}, {"sum_totalprice_80", 229815.16f}, {"sum_totalprice_50", 99498.77f}};
+		for (const auto &[name, to] : queries)
+		{
+			std::function<double(const Huffman::compressedData<float, 64>&)> func = [to = to](const Huffman::compressedData<float, 64> &col) {
+				return Huffman::sum_where_op_range<float, 64>(col, {}, to);
+			};
+			auto runtimes = Huffman::benchmark_op_with_dtype<float, double>(compressedData, runs, warmup, clearCache, func);
+			CSV::writeSingleColumn<size_t>(columnName, runtimes, dataDirectory + "AGG__TOTALPRICE__" + name + ".csv");
+		}
+
+		// All three sums in one pass over the blocks
+		std::vector<Shared::predicate<float>> predicates;
+		for (const auto &[name, to] : queries)
+		{
+			predicates.push_back([to = to](float v) { return !to || v < *to; });
+		}
+		std::function<double(const Huffman::compressedData<float, 64>&)> shared = [&predicates](const Huffman::compressedData<float, 64> &col) {
+			return Shared::scan(col, predicates)[0].sum;
+		};
+		auto runtimes = Huffman::benchmark_op_with_dtype<float, double>(compressedData, runs, warmup, clearCache, shared);
+		CSV::writeSingleColumn<size_t>(columnName, runtimes, dataDirectory + "AGG__TOTALPRICE__shared_sum_totalprice_all.csv");
+	}
+
+	{
+		// SUM(TOTALPRICE) WHERE ORDERDATE < 1996-01-02 AND ORDERSTATUS = 'O': filters on two Dictionary columns,
+		// TOTALPRICE is only decoded at the selected rows
+		std::cout << "QUERY" << std::endl;
+		const auto &dates = std::get<std::vector<Date::date16>>(Schema::column(table, "ORDERDATE").values);
+		const auto &statuses = std::get<std::vector<std::string>>(Schema::column(table, "ORDERSTATUS").values);
+		const auto &prices = std::get<std::vector<float>>(Schema::column(table, "TOTALPRICE").values);
+		auto compressedDates = Dictionary::compress<Date::date16, uint16_t>(dates);
+		auto compressedStatuses = Dictionary::compress<std::string, uint8_t>(statuses);
+		auto dateStats = Statistics::compute(compressedDates);
+		auto statusStats = Statistics::compute(compressedStatuses);
+		Huffman::compressedData<float, 64> compressedPrices;
+		auto compressedColumn = Huffman::compress<float, 64>(prices, &compressedPrices.aggregates);
+		compressedPrices.dictionary = std::get<0>(compressedColumn);
+		compressedPrices.compressed = std::get<1>(compressedColumn);
+		compressedPrices.bounds = std::get<2>(compressedColumn);
+
+		auto date = Date::parse<uint16_t>("1996-01-02");
+		std::vector<Query::filter> filters = {
+			Query::dictionary_range_filter<Date::date16, uint16_t>("ORDERDATE", compressedDates, dateStats, {}, date),
+			Query::dictionary_filter<std::string, uint8_t>("ORDERSTATUS", compressedStatuses, statusStats, [](std::string v) { return v == "O"; }),
+		};
+		auto totalPrice = Query::huffman_source(compressedPrices);
+		std::function<double ()> query = [&filters, &totalPrice]() {
+			return Query::sum(totalPrice, Query::where(filters));
+		};
+		std::cout << "SUM(TOTALPRICE) = " << query() << std::endl;
+		auto runtimes = Benchmark::benchmark(query, runs, warmup, clearCache);
+		std::string columnName = "QUERY";
+		CSV::writeSingleColumn<size_t>(columnName, runtimes, dataDirectory + "AGG__QUERY__sum_totalprice_where_date_status.csv");
+	}
+
 	{
 		//CLERK:​
 		std::cout << "CLERK" << std::endl;
-		int i = 6; //CLERK
-		std::vector<std::string> convertedColumn;
-		std::transform(table[i].begin(), table[i].end(), std::back_inserter(convertedColumn), [](const std::string &str) { return str; });
+		const auto &convertedColumn = std::get<std::vector<std::string>>(Schema::column(table, "CLERK").values);
 		auto compressedColumn = Huffman::compress<std::string, 64>(convertedColumn);
 		Huffman::compressedData<std::string, 64> compressedData;
 		compressedData.dictionary = std::get<0>(compressedColumn);
@@ -600,12 +925,33 @@ void slidesBenchmark(std::vector<std::vector<std::string>> &table, std::vector<s
 
 		// 80 (80.31 %): x >= "Clerk#000001980"​
 		std::cout << "80 (80.31 %): x >= Clerk#000001980" << std::endl;
-		auto func = [](Huffman::compressedData<std::string, 64> col) {
+		auto func = [](const Huffman::compressedData<std::string, 64> &col) {
 			return Huffman::count_where_op_range<std::string, 64>(col.dictionary, col.compressed, col.bounds, {"Clerk#000001980"}, {});
 		};
 		auto runtimes = Huffman::benchmark_op_with_dtype<std::string, size_t>(compressedData, runs, warmup, clearCache, func);
 		opResult.aggregateRuntimes.push_back(runtimes);
 		opResult.aggregateNames.push_back("count_clerk_80");
+
+		// Equality and IN-list: only blocks whose membership filter may hold a value are decoded
+		Huffman::build_filter(compressedData);
+		auto funcEqual = [](const Huffman::compressedData<std::string, 64> &col) {
+			return Huffman::count_where_op_equal<std::string, 64>(col, std::string("Clerk#000000741"));
+		};
+		runtimes = Huffman::benchmark_op_with_dtype<std::string, size_t>(compressedData, runs, warmup, clearCache, funcEqual);
+		opResult.aggregateRuntimes.push_back(runtimes);
+		opResult.aggregateNames.push_back("count_clerk_equal");
+		auto funcIn = [](const Huffman::compressedData<std::string, 64> &col) {
+			return Huffman::count_where_op_in<std::string, 64>(col, {"Clerk#000000741", "Clerk#000001980", "Clerk#000005100"});
+		};
+		runtimes = Huffman::benchmark_op_with_dtype<std::string, size_t>(compressedData, runs, warmup, clearCache, funcIn);
+		opResult.aggregateRuntimes.push_back(runtimes);
+		opResult.aggregateNames.push_back("count_clerk_in");
+		auto funcDistinct = [](const Huffman::compressedData<std::string, 64> &col) {
+			return Huffman::count_distinct_op<std::string, 64>(col);
+		};
+		runtimes = Huffman::benchmark_op_with_dtype<std::string, size_t>(compressedData, runs, warmup, clearCache, funcDistinct);
+		opResult.aggregateRuntimes.push_back(runtimes);
+		opResult.aggregateNames.push_back("count_distinct_clerk");
 		results.push_back(opResult);
 		
 		// // 50 (50.17 %): x <= "Clerk#000005100"​
@@ -794,6 +1140,140 @@ for (int j = 0; j < results.size(); ++j)
 }
 }
 
+/**
+	Equality, IN and conjunctions on the low-cardinality ORDERSTATUS and ORDERPRIORITY columns,
+	answered from inverted bitmap indexes instead of scans.
+*/
+void bitmapIndexBenchmark(std::vector<Schema::typedColumn> &table, int runs, int warmup, bool clearCache)
+{
+	std::string dataDirectory = "../data/bitmap_index/";
+	const auto &status = std::get<std::vector<std::string>>(Schema::column(table, "ORDERSTATUS").values);
+	const auto &priority = std::get<std::vector<std::string>>(Schema::column(table, "ORDERPRIORITY").values);
+	auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+	auto compressedPriority = Dictionary::compress<std::string, uint8_t>(priority);
+
+	std::cout << "Bitmap Index - Building indexes" << std::endl;
+	auto statusIndex = BitmapIndex::build(compressedStatus);
+	auto priorityIndex = BitmapIndex::build(compressedPriority);
+	std::cout << "Bitmap Index - ORDERSTATUS: " << BitmapIndex::sizeInBytes(statusIndex) << " bytes, ORDERPRIORITY: "
+			  << BitmapIndex::sizeInBytes(priorityIndex) << " bytes" << std::endl;
+
+	std::vector<std::string> urgent = {"1-URGENT", "2-HIGH"};
+	std::vector<std::pair<std::string, std::function<size_t ()>>> queries = {
+		{"count_where_status_equals_O", [&]() {
+			return BitmapIndex::count_where_op_equal(statusIndex, compressedStatus.first, std::string("O"));
+		}},
+		{"count_where_priority_in_urgent_high", [&]() {
+			return BitmapIndex::count_where_op_in(priorityIndex, compressedPriority.first, urgent);
+		}},
+		{"count_where_status_O_and_priority_in_urgent_high", [&]() {
+			return BitmapIndex::conjunction({BitmapIndex::equal(statusIndex, compressedStatus.first, std::string("O")),
+											 BitmapIndex::in(priorityIndex, compressedPriority.first, urgent)}).cardinality();
+		}},
+		{"scan_where_status_O_and_priority_in_urgent_high", [&]() {
+			// Same conjunction without index: one pass over both attribute vectors
+			std::vector<uint8_t> isOpen(compressedStatus.first.size());
+			for (size_t code = 0; code < isOpen.size(); ++code) {
+				isOpen[code] = compressedStatus.first[code] == "O";
+			}
+			std::vector<uint8_t> isUrgent(compressedPriority.first.size());
+			for (size_t code = 0; code < isUrgent.size(); ++code) {
+				isUrgent[code] = std::find(urgent.begin(), urgent.end(), compressedPriority.first[code]) != urgent.end();
+			}
+			size_t count = 0;
+			for (size_t i = 0; i < compressedStatus.second.size(); ++i) {
+				count += isOpen[compressedStatus.second[i]] & isUrgent[compressedPriority.second[i]];
+			}
+			return count;
+		}},
+	};
+	for (auto &[name, query] : queries)
+	{
+		std::cout << "Bitmap Index - " << name << ": " << query() << std::endl;
+		auto runtimes = Benchmark::benchmark(query, runs, warmup, clearCache);
+		std::string columnName = name;
+		CSV::writeSingleColumn<size_t>(columnName, runtimes, dataDirectory + "AGG__" + name + ".csv");
+	}
+}
+
+/**
+	ORDERS join CUSTOMER on CUSTKEY: both key columns are encoded against one shared dictionary and joined on codes.
+*/
+void joinBenchmark(std::vector<Schema::typedColumn> &table, std::string customerFile, std::string customerSchemaFile, int runs, int warmup, bool clearCache)
+{
+	std::string dataDirectory = "../data/join/";
+	std::cout << "Join - Loading " << customerFile << std::endl;
+	auto customerTable = Schema::load(customerFile, Schema::fromFile(customerSchemaFile));
+	const auto &orderKeys = std::get<std::vector<int32_t>>(Schema::column(table, "CUSTKEY").values);
+	const auto &customerKeys = std::get<std::vector<int32_t>>(Schema::column(customerTable, "CUSTKEY").values);
+	auto shared = Join::compress<int32_t, uint32_t>({&customerKeys, &orderKeys});
+	std::cout << "Join - Shared dictionary of " << shared.dictionary.size() << " keys" << std::endl;
+
+	std::vector<std::pair<std::string, std::function<size_t ()>>> joins = {
+		{"join_custkey", [&shared]() {
+			return Join::join(shared, 0, 1).size();
+		}},
+		{"direct_join_custkey", [&shared]() {
+			return Join::direct_join(shared.codes[0], shared.codes[1], shared.dictionary.size()).size();
+		}},
+		{"hash_join_custkey", [&shared]() {
+			return Join::hash_join(shared.codes[0], shared.codes[1]).size();
+		}},
+	};
+	for (auto &[name, join] : joins)
+	{
+		std::cout << "Join - " << name << ": " << join() << " rows" << std::endl;
+		auto runtimes = Benchmark::benchmark(join, runs, warmup, clearCache);
+		std::string columnName = name;
+		CSV::writeSingleColumn<size_t>(columnName, runtimes, dataDirectory + "AGG__" + name + ".csv");
+	}
+}
+
+/**
+	Streams the table row group by row group into one memory-mappable column file,
+	without loading the whole table.
+*/
+void saveStore(std::string dataFile, const std::vector<Schema::field> &schema, std::string storeFile, size_t rowsPerGroup)
+{
+	std::cout << "Store - Writing " << dataFile << " in row groups of " << rowsPerGroup << " rows" << std::endl;
+	auto start = std::chrono::system_clock::now();
+	size_t rowGroups = RowGroup::compress(dataFile, schema, storeFile, rowsPerGroup);
+	auto end = std::chrono::system_clock::now();
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << "Store - Written " << rowGroups << " row groups to " << storeFile << " in " << elapsed << " nanoseconds" << std::endl;
+}
+
+/**
+	Opens a column file written by saveStore() and queries it in place.
+*/
+void loadStore(std::string storeFile)
+{
+	std::cout << "Store - Opening " << storeFile << std::endl;
+	auto start = std::chrono::system_clock::now();
+	Storage::File file(storeFile);
+	auto end = std::chrono::system_clock::now();
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << "Store - Opened in " << elapsed << " nanoseconds" << std::endl;
+	for (size_t i = 0; i < file.columnCount(); ++i)
+	{
+		const auto &entry = file.entry(i);
+		std::cout << "Store - " << entry.name << " (row group " << entry.rowGroup << "): " << entry.rows << " rows, " << entry.nullCount << " nulls, "
+				  << entry.dictionarySize << " uniques, " << (int)entry.codeWidth << " byte codes" << std::endl;
+	}
+	// ORDERSTATUS
+	start = std::chrono::system_clock::now();
+	size_t count = RowGroup::count_where_op<std::string>(file, "ORDERSTATUS", [](std::string_view s) { return s == "O"; });
+	end = std::chrono::system_clock::now();
+	elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << "Store - count_where_equals_O: " << count << " in " << elapsed << " nanoseconds" << std::endl;
+	// ORDERDATE < 1996-01-02, row groups outside the range are skipped by their statistics
+	start = std::chrono::system_clock::now();
+	count = RowGroup::count_where_op_range<Date::date16>(file, "ORDERDATE", {}, Date::parse<uint16_t>("1996-01-02"));
+	end = std::chrono::system_clock::now();
+	elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << "Store - count_where_range_less_1996-01-02: " << count << " in " << elapsed << " nanoseconds" << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
 	int runs = 1;
@@ -806,14 +1286,52 @@ int main(int argc, char *argv[])
 	{
 		args.push_back(argv[i]);
 	}
+	std::string dataFile = "../data/order.tbl";
+	std::string schemaFile = "../data/order.schema";
+	size_t rowsPerGroup = RowGroup::DEFAULT_ROWS;
+	size_t threads = 1;
+	Pool::Mode mode = Pool::Mode::Isolated;
 	bool dictionary = false;
 	bool huffman = false;
 	bool compress = false;
 	bool op = false;
 	bool slides = false;
-	for (auto arg : args)
+	bool fsst = false;
+	bool cascade = false;
+	bool blockLocal = false;
+	bool saveToStore = false;
+	bool loadFromStore = false;
+	bool bitmapIndex = false;
+	bool join = false;
+	for (size_t a = 0; a < args.size(); ++a)
 	{
-		if (arg == "-dictionary")
+		auto arg = args[a];
+		if (arg == "-table" && a + 1 < args.size())
+		{
+			dataFile = args[++a];
+			std::cout << "Using table: " << dataFile << std::endl;
+		}
+		else if (arg == "-schema" && a + 1 < args.size())
+		{
+			schemaFile = args[++a];
+			std::cout << "Using schema: " << schemaFile << std::endl;
+		}
+		else if (arg == "-row-group" && a + 1 < args.size())
+		{
+			rowsPerGroup = std::stoul(args[++a]);
+			std::cout << "Using row groups of " << rowsPerGroup << " rows" << std::endl;
+		}
+		else if (arg == "-threads" && a + 1 < args.size())
+		{
+			threads = std::stoul(args[++a]);
+			std::cout << "Using " << threads << " threads" << std::endl;
+		}
+		else if (arg == "-throughput")
+		{
+			std::cout << "Enabled: throughput mode (columns benchmarked concurrently)" << std::endl;
+			mode = Pool::Mode::Throughput;
+		}
+		else if (arg == "-dictionary")
 		{
 			std::cout << "Enabled: dictionary" << std::endl;
 			dictionary = true;
@@ -838,20 +1356,55 @@ int main(int argc, char *argv[])
 			std::cout << "Enabled: benchmark for aggregation in slides" << std::endl;
 			slides = true;
 		}
+		else if (arg == "-cascade")
+		{
+			std::cout << "Enabled: cascading compression for dictionary" << std::endl;
+			cascade = true;
+		}
+		else if (arg == "-block-local")
+		{
+			std::cout << "Enabled: block-local dictionaries for dictionary" << std::endl;
+			blockLocal = true;
+		}
+		else if (arg == "-save-store")
+		{
+			std::cout << "Enabled: write column file" << std::endl;
+			saveToStore = true;
+		}
+		else if (arg == "-load-store")
+		{
+			std::cout << "Enabled: query column file" << std::endl;
+			loadFromStore = true;
+		}
+		else if (arg == "-bitmap-index")
+		{
+			std::cout << "Enabled: bitmap index benchmark" << std::endl;
+			bitmapIndex = true;
+		}
+		else if (arg == "-join")
+		{
+			std::cout << "Enabled: join benchmark" << std::endl;
+			join = true;
+		}
+		else if (arg == "-fsst")
+		{
+			std::cout << "Enabled: fsst" << std::endl;
+			fsst = true;
+		}
 		else
 		{
-			std::cerr << arg << " is an unrecognised flag.\nThe following flags are allowed:\n\t-dictionary\n\t-huffman\n\t-compress (enables compression benchmarks)\n\t-op (enables operation benchmarks)\n\tor no flag of either pairs to enable both" << std::endl;
+			std::cerr << arg << " is an unrecognised flag.\nThe following flags are allowed:\n\t-dictionary\n\t-huffman\n\t-fsst\n\t-cascade (dictionary with second-stage encoding)\n\t-block-local (dictionary with one dictionary per 64K rows)\n\t-bitmap-index (equality, IN and AND on inverted bitmap indexes)\n\t-join (join with customer.tbl next to the table on CUSTKEY)\n\t-save-store (stream the table into ../data/order.tucol)\n\t-row-group <rows> (rows per row group of -save-store, default 65536)\n\t-load-store (query ../data/order.tucol without parsing the table)\n\t-table <file> (default ../data/order.tbl)\n\t-schema <file> (column types of the table, default ../data/order.schema)\n\t-threads <n> (worker threads, default 1)\n\t-throughput (benchmark columns concurrently instead of one at a time)\n\t-compress (enables compression benchmarks)\n\t-op (enables operation benchmarks)\n\tor no flag of either pairs to enable both" << std::endl;
 			return 1;
 		}
 	}
-	if (compress == false && op == false && !slides)
+	if (compress == false && op == false && !slides && !bitmapIndex && !join)
 	{
 		std::cout << "Enabled: compress" << std::endl;
 		compress = true;
 		std::cout << "Enabled: op" << std::endl;
 		op = true;
 	}
-	if (dictionary == false && huffman == false && !slides)
+	if (dictionary == false && huffman == false && !slides && !fsst && !saveToStore && !loadFromStore && !bitmapIndex && !join)
 	{
 		std::cout << "Enabled: dictionary" << std::endl;
 		dictionary = true;
@@ -859,12 +1412,28 @@ int main(int argc, char *argv[])
 		huffman = true;
 	}
 
+	std::string storeFile = dataFile.substr(0, dataFile.rfind(".tbl")) + ".tucol";
+	if (loadFromStore)
+	{
+		loadStore(storeFile);
+		return 1;
+	}
+
+	auto schema = Schema::fromFile(schemaFile);
+	if (saveToStore)
+	{
+		saveStore(dataFile, schema, storeFile, rowsPerGroup);
+	}
+	if (!dictionary && !huffman && !slides && !fsst && !bitmapIndex && !join)
+	{
+		return 1;
+	}
+
 	// ------------------- Load Table -------------- //
-	std::string dataFile = "../data/order.tbl";
-	auto header = CSV::headerFromFile(dataFile);
+	auto header = Schema::names(schema);
 	std::cout << "Loading table" << std::endl;
 	auto start = std::chrono::system_clock::now();
-	auto table = CSV::toColumnStore(dataFile);
+	auto table = Schema::load(dataFile, schema);
 	auto end = std::chrono::system_clock::now();
 	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 	std::cout << "Finished loading in " << elapsed << " nanoseconds" << std::endl;
@@ -876,21 +1445,36 @@ int main(int argc, char *argv[])
 	std::string cTimesFile = "compression_times.csv";
 	std::string dcTimesFile = "decompression_times.csv";
 
+	Pool::ThreadPool pool(threads, Pool::detect_topology());
+
 	// ------------------- Dictionary -------------- //
 	try
 	{
 		if (dictionary)
 		{
-			fullDictionaryBenchmark(table, header, runs, warmup, clearCache, compress, op, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile);
+			fullDictionaryBenchmark(table, header, runs, warmup, clearCache, compress, op, cascade, blockLocal, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile, pool, mode);
 		}
 		if (huffman)
 		{
-			fullHuffmanBenchmark(table, header, runs, warmup, clearCache, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile);
+			fullHuffmanBenchmark(table, header, runs, warmup, clearCache, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile, pool, mode);
+		}
+		if (fsst)
+		{
+			fullFSSTBenchmark(table, header, runs, warmup, clearCache, compress, op, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile);
 		}
 		if (slides)
 		{
 			slidesBenchmark(table, header, runs, warmup, clearCache, cRatioFile, cSizeFile, uSizeFile, cTimesFile, dcTimesFile);
 		}
+		if (bitmapIndex)
+		{
+			bitmapIndexBenchmark(table, runs, warmup, clearCache);
+		}
+		if (join)
+		{
+			std::string directory = dataFile.substr(0, dataFile.rfind('/') + 1);
+			joinBenchmark(table, directory + "customer.tbl", directory + "customer.schema", runs, warmup, clearCache);
+		}
 	}
 	catch (const std::invalid_argument &e)
 	{
@@ -901,8 +1485,8 @@ int main(int argc, char *argv[])
 	// gcc version 7.3.0
 
 	// With optmizations
-	// gcc main.cpp -lstdc++ -std=c++1z -O2 -o main
+	// gcc main.cpp -lstdc++ -std=c++1z -O2 -pthread -o main
 
 	// Without optimizations (we have to link math with -lm)
-	// gcc main.cpp -lstdc++ -std=c++1z -lm -o main
+	// gcc main.cpp -lstdc++ -std=c++1z -lm -pthread -o main
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+namespace Morsel
+{
+
+/**
+	Rows per morsel: large enough that scheduling costs vanish, small enough that idle workers find work to steal
+	until the end of the scan. Morsel boundaries do not depend on the number of threads, neither do the results.
+*/
+const size_t MORSEL_SIZE = size_t(1) << 16;
+
+/**
+	Dictionaries with at most this many entries are counted in one histogram per worker, wider ones in a single shared
+	histogram (atomic increments, rarely on the same entry).
+*/
+const size_t HISTOGRAM_MAX = size_t(1) << 16;
+
+/**
+	Placed attribute vectors start on a page boundary. MORSEL_SIZE * sizeof(C) is a multiple of the page size,
+	so no page holds codes of two morsels (and two nodes).
+*/
+const size_t PAGE_SIZE = 4096;
+
+/**
+	Attribute vector spread over the NUMA nodes of a pool: morsel m lives on node m % nodes. The pages of every morsel
+	are first written by a worker of its node, so the kernel places them there (first touch).
+	The dictionary is shared and has to outlive the column.
+*/
+template <typename D, typename C>
+struct placedColumn {
+	const std::vector<D> *dictionary = nullptr;
+	std::unique_ptr<C[], void (*)(void *)> codes{nullptr, std::free};
+	size_t size = 0;
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+inline size_t morsels(size_t rows) {
+	return (rows + MORSEL_SIZE - 1) / MORSEL_SIZE;
+}
+
+/**
+	Runs fn(m, first, last) for every morsel [first, last) of rows and returns when all are done.
+	Placed columns send each morsel to its node, others let any worker take it. Strict morsels only run on their node.
+*/
+template <typename F>
+void for_each_morsel(Pool::ThreadPool &pool, size_t rows, bool placed, F fn, bool strict = false) {
+	std::vector<std::future<void>> tasks;
+	for (size_t m = 0; m < morsels(rows); ++m) {
+		size_t first = m * MORSEL_SIZE;
+		size_t last = std::min(rows, first + MORSEL_SIZE);
+		tasks.push_back(pool.submit([&fn, m, first, last] { fn(m, first, last); }, placed ? m % pool.nodes() : Pool::ANY_NODE, strict));
+	}
+	for (auto &task : tasks) {
+		pool.wait(task);
+	}
+}
+
+/**
+	Partial results of fn(m, first, last) in morsel order.
+*/
+template <typename R, typename F>
+std::vector<R> map_morsels(Pool::ThreadPool &pool, size_t rows, bool placed, F fn) {
+	std::vector<R> partials(morsels(rows));
+	for_each_morsel(pool, rows, placed, [&partials, &fn](size_t m, size_t first, size_t last) {
+		partials[m] = fn(m, first, last);
+	});
+	return partials;
+}
+
+template <typename D>
+std::vector<uint8_t> matches(const std::vector<D> &dictionary, const std::function<bool (D)> &predicate) {
+	std::vector<uint8_t> result(dictionary.size());
+	for (size_t code = 0; code < dictionary.size(); ++code) {
+		result[code] = predicate(dictionary[code]);
+	}
+	return result;
+}
+
+template <typename D, typename C>
+size_t count_where(Pool::ThreadPool &pool, const std::vector<D> &dictionary, const C *codes, size_t rows, bool placed,
+                   std::function<bool (D)> predicate) {
+	auto match = matches(dictionary, predicate);
+	auto partials = map_morsels<size_t>(pool, rows, placed, [&](size_t m, size_t first, size_t last) {
+		size_t count = 0;
+		for (size_t i = first; i < last; ++i) {
+			count += match[codes[i]];
+		}
+		return count;
+	});
+	return std::accumulate(partials.begin(), partials.end(), size_t(0));
+}
+
+/**
+	Rows per code of the whole column, counted in parallel. Integer counts add up the same in any order.
+*/
+template <typename C>
+std::vector<size_t> histogram(Pool::ThreadPool &pool, size_t domain, const C *codes, size_t rows, bool placed) {
+	std::vector<size_t> counts(domain, 0);
+	if (domain <= HISTOGRAM_MAX) {
+		// One histogram per worker and one for a thread outside the pool
+		std::vector<std::vector<size_t>> histograms(pool.size() + 1);
+		for_each_morsel(pool, rows, placed, [&](size_t m, size_t first, size_t last) {
+			auto &local = histograms[pool.worker()];
+			local.resize(domain, 0);
+			for (size_t i = first; i < last; ++i) {
+				++local[codes[i]];
+			}
+		});
+		for (const auto &local : histograms) {
+			for (size_t code = 0; code < local.size(); ++code) {
+				counts[code] += local[code];
+			}
+		}
+		return counts;
+	}
+	std::unique_ptr<std::atomic<size_t>[]> shared(new std::atomic<size_t>[domain]);
+	for (size_t code = 0; code < domain; ++code) {
+		shared[code].store(0, std::memory_order_relaxed);
+	}
+	for_each_morsel(pool, rows, placed, [&](size_t m, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			shared[codes[i]].fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+	for (size_t code = 0; code < domain; ++code) {
+		counts[code] = shared[code].load(std::memory_order_relaxed);
+	}
+	return counts;
+}
+
+/**
+	The sum is built per code in code order from the histogram, as Dictionary::sum_op does after sorting a copy
+	of the attribute vector, so both return the same value.
+*/
+template <typename D, typename C>
+size_t sum(Pool::ThreadPool &pool, const std::vector<D> &dictionary, const C *codes, size_t rows, bool placed) {
+	size_t total_sum = 0;
+	auto counts = histogram(pool, dictionary.size(), codes, rows, placed);
+	for (size_t code = 0; code < dictionary.size(); ++code) {
+		if (counts[code] > 0) {
+			total_sum += dictionary[code] * counts[code];
+		}
+	}
+	return total_sum;
+}
+
+template <typename D, typename C>
+std::vector<D> where_view(Pool::ThreadPool &pool, const std::vector<D> &dictionary, const C *codes, size_t rows, bool placed,
+                          std::function<bool (D)> predicate) {
+	auto match = matches(dictionary, predicate);
+	auto partials = map_morsels<std::vector<D>>(pool, rows, placed, [&](size_t m, size_t first, size_t last) {
+		std::vector<D> values;
+		for (size_t i = first; i < last; ++i) {
+			if (match[codes[i]]) {
+				values.push_back(dictionary[codes[i]]);
+			}
+		}
+		return values;
+	});
+	std::vector<D> result;
+	for (auto &partial : partials) {
+		result.insert(result.end(), std::make_move_iterator(partial.begin()), std::make_move_iterator(partial.end()));
+	}
+	return result;
+}
+
+template <typename D, typename C>
+std::vector<D> decompress(Pool::ThreadPool &pool, const std::vector<D> &dictionary, const C *codes, size_t rows, bool placed) {
+	std::vector<D> result(rows);
+	for_each_morsel(pool, rows, placed, [&](size_t m, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			result[i] = dictionary[codes[i]];
+		}
+	});
+	return result;
+}
+
+// ---------------------- PLACEMENT ------------------ //
+
+/**
+	Copies the attribute vector into a placedColumn. The copy is allocated page aligned without being written, every
+	morsel is then copied by a worker of its node (strict tasks, never stolen by another node).
+*/
+template <typename D, typename C>
+placedColumn<D, C> place(Pool::ThreadPool &pool, const std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	placedColumn<D, C> placed;
+	placed.dictionary = &compressed.first;
+	placed.size = compressed.second.size();
+	static_assert(MORSEL_SIZE * sizeof(C) % PAGE_SIZE == 0, "Morsels must cover whole pages");
+	size_t bytes = (placed.size * sizeof(C) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+	placed.codes.reset(static_cast<C *>(std::aligned_alloc(PAGE_SIZE, std::max(bytes, PAGE_SIZE))));
+	if (!placed.codes) {
+		throw std::bad_alloc();
+	}
+	C *codes = placed.codes.get();
+	for_each_morsel(pool, placed.size, true, [&](size_t m, size_t first, size_t last) {
+		std::copy(compressed.second.begin() + first, compressed.second.begin() + last, codes + first);
+	}, true);
+	return placed;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Parallel counterparts of the Dictionary ops, with equal results. Each takes a Dictionary compressed column
+	(morsels go to any worker) or a placed one (morsels go to the node holding them).
+*/
+template <typename D, typename C>
+size_t count_where_op(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed, std::function<bool (D)> predicate) {
+	return count_where(pool, compressed.first, compressed.second.data(), compressed.second.size(), false, predicate);
+}
+
+template <typename D, typename C>
+size_t count_where_op(Pool::ThreadPool &pool, const placedColumn<D, C> &column, std::function<bool (D)> predicate) {
+	return count_where(pool, *column.dictionary, column.codes.get(), column.size, true, predicate);
+}
+
+template <typename D, typename C>
+size_t sum_op(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return sum(pool, compressed.first, compressed.second.data(), compressed.second.size(), false);
+}
+
+template <typename D, typename C>
+size_t sum_op(Pool::ThreadPool &pool, const placedColumn<D, C> &column) {
+	return sum(pool, *column.dictionary, column.codes.get(), column.size, true);
+}
+
+template <typename D, typename C>
+float avg_op(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	if (compressed.first.size() == 1) {
+		return compressed.first[0];
+	}
+	return (float)sum_op(pool, compressed) / (float)compressed.second.size();
+}
+
+template <typename D, typename C>
+float avg_op(Pool::ThreadPool &pool, const placedColumn<D, C> &column) {
+	if (column.dictionary->size() == 1) {
+		return (*column.dictionary)[0];
+	}
+	return (float)sum_op(pool, column) / (float)column.size;
+}
+
+/**
+	Values matching the predicate, in row order.
+*/
+template <typename D, typename C>
+std::vector<D> where_view_op(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed, std::function<bool (D)> predicate) {
+	return where_view(pool, compressed.first, compressed.second.data(), compressed.second.size(), false, predicate);
+}
+
+template <typename D, typename C>
+std::vector<D> where_view_op(Pool::ThreadPool &pool, const placedColumn<D, C> &column, std::function<bool (D)> predicate) {
+	return where_view(pool, *column.dictionary, column.codes.get(), column.size, true, predicate);
+}
+
+template <typename D, typename C>
+std::vector<D> decompress(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return decompress(pool, compressed.first, compressed.second.data(), compressed.second.size(), false);
+}
+
+template <typename D, typename C>
+std::vector<D> decompress(Pool::ThreadPool &pool, const placedColumn<D, C> &column) {
+	return decompress(pool, *column.dictionary, column.codes.get(), column.size, true);
+}
+
+} // end namespace Morsel
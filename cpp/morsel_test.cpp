@@ -0,0 +1,80 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "pool.cpp"
+#include "morsel.cpp"
+
+/**
+	Parallel ops return exactly what the sequential Dictionary ops return.
+*/
+template <typename D, typename C>
+void assertOps(Pool::ThreadPool &pool, std::pair<std::vector<D>, std::vector<C>> &compressed, std::function<bool (D)> predicate) {
+	auto placed = Morsel::place(pool, compressed);
+	assert((uintptr_t)placed.codes.get() % Morsel::PAGE_SIZE == 0);
+	assert(std::equal(compressed.second.begin(), compressed.second.end(), placed.codes.get()));
+	assert(Morsel::count_where_op(pool, compressed, predicate) == Dictionary::count_where_op(compressed, predicate));
+	assert(Morsel::count_where_op(pool, placed, predicate) == Dictionary::count_where_op(compressed, predicate));
+	assert(Morsel::sum_op(pool, compressed) == Dictionary::sum_op(compressed));
+	assert(Morsel::sum_op(pool, placed) == Dictionary::sum_op(compressed));
+	assert(Morsel::avg_op(pool, compressed) == Dictionary::avg_op(compressed));
+	assert(Morsel::avg_op(pool, placed) == Dictionary::avg_op(compressed));
+	assert(Morsel::where_view_op(pool, compressed, predicate) == Dictionary::where_view_op(compressed, predicate));
+	assert(Morsel::where_view_op(pool, placed, predicate) == Dictionary::where_view_op(compressed, predicate));
+	assert(Morsel::decompress(pool, compressed) == Dictionary::decompress(compressed));
+	assert(Morsel::decompress(pool, placed) == Dictionary::decompress(compressed));
+}
+
+int main(int argc, char const *argv[])
+{
+	// Several morsels, the last one partial
+	size_t rows = 3 * Morsel::MORSEL_SIZE + 1234;
+	std::vector<float> prices;
+	std::vector<int> keys;
+	std::vector<std::string> status;
+	for (size_t i = 0; i < rows; ++i) {
+		prices.push_back((i * 7919 % 10007) / 4.0f);
+		keys.push_back(i * 31 % 100003);
+		status.push_back(i % 3 == 0 ? "O" : (i % 3 == 1 ? "F" : "P"));
+	}
+	auto compressedPrices = Dictionary::compress<float, uint16_t>(prices);
+	auto compressedKeys = Dictionary::compress<int, uint32_t>(keys);
+	auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+	assert(compressedKeys.first.size() > Morsel::HISTOGRAM_MAX);
+
+	std::cout << "#### TEST MORSEL OPS ####" << std::endl;
+	for (size_t threads : {1, 4}) {
+		Pool::ThreadPool pool(threads);
+		assertOps<float, uint16_t>(pool, compressedPrices, [](float v) { return v < 100; });
+		assertOps<int, uint32_t>(pool, compressedKeys, [](int v) { return v < 100; });
+		std::function<bool (std::string)> isOpen = [](std::string v) { return v == "O"; };
+		auto placed = Morsel::place(pool, compressedStatus);
+		assert(Morsel::count_where_op(pool, placed, isOpen) == Dictionary::count_where_op(compressedStatus, isOpen));
+		assert(Morsel::where_view_op(pool, placed, isOpen) == Dictionary::where_view_op(compressedStatus, isOpen));
+		assert(Morsel::decompress(pool, placed) == status);
+	}
+	std::cout << "#### TEST NUMA PLACEMENT ####" << std::endl;
+	{
+		Pool::ThreadPool pool(4, Pool::topology{{{0}, {0}}});
+		assertOps<float, uint16_t>(pool, compressedPrices, [](float v) { return v >= 2450; });
+		assertOps<int, uint32_t>(pool, compressedKeys, [](int v) { return v < 50; });
+	}
+	std::cout << "#### TEST EDGE CASES ####" << std::endl;
+	{
+		Pool::ThreadPool pool(2);
+		std::pair<std::vector<int>, std::vector<uint8_t>> empty;
+		assert(Morsel::sum_op(pool, empty) == 0);
+		assert(Morsel::decompress(pool, empty).empty());
+		std::pair<std::vector<int>, std::vector<uint8_t>> single = {{7}, {0, 0, 0}};
+		assert(Morsel::sum_op(pool, single) == 21 && Morsel::avg_op(pool, single) == 7);
+	}
+	return 0;
+}
@@ -0,0 +1,210 @@
+#include <cstring>
+#include <string_view>
+
+namespace Pattern
+{
+
+/**
+	All entries of a sorted string dictionary back to back: entry `code` is bytes[offsets[code], offsets[code + 1]).
+	Substring searches run over the whole pool at once instead of once per std::string.
+*/
+struct stringPool {
+	std::string bytes;
+	std::vector<size_t> offsets;
+
+	size_t size() const { return offsets.size() - 1; }
+	std::string_view entry(size_t code) const { return std::string_view(bytes).substr(offsets[code], offsets[code + 1] - offsets[code]); }
+};
+
+/**
+	Codes matching a pattern: either the contiguous range [first, second) (prefixes) or,
+	if bitmap is not empty, every code with bitmap[code] == 1.
+*/
+struct codeMatch {
+	size_t first = 0;
+	size_t second = 0;
+	std::vector<uint8_t> bitmap;
+
+	bool contains(size_t code) const { return bitmap.empty() ? code >= first && code < second : bitmap[code]; }
+};
+
+stringPool pool(const std::vector<std::string> &dictionary) {
+	stringPool result;
+	result.offsets.reserve(dictionary.size() + 1);
+	result.offsets.push_back(0);
+	for (const auto &entry : dictionary) {
+		result.bytes += entry;
+		result.offsets.push_back(result.bytes.size());
+	}
+	return result;
+}
+
+// ---------------------- PATTERNS ------------------ //
+
+/**
+	Entries starting with prefix are contiguous in a sorted dictionary: two binary searches.
+*/
+codeMatch prefix(const std::vector<std::string> &dictionary, std::string_view prefix) {
+	auto first = std::partition_point(dictionary.begin(), dictionary.end(), [prefix](const std::string &entry) {
+		return std::string_view(entry).substr(0, prefix.size()) < prefix;
+	});
+	auto second = std::partition_point(first, dictionary.end(), [prefix](const std::string &entry) {
+		return std::string_view(entry).substr(0, prefix.size()) == prefix;
+	});
+	codeMatch match;
+	match.first = first - dictionary.begin();
+	match.second = second - dictionary.begin();
+	return match;
+}
+
+/**
+	Entries containing needle. memmem scans the pool, every hit is mapped to its entry with a binary search
+	over the offsets and the search continues at the next entry. Hits crossing an entry boundary are not matches.
+*/
+codeMatch contains(const stringPool &pool, std::string_view needle) {
+	codeMatch match;
+	match.bitmap.assign(pool.size(), needle.empty());
+	if (needle.empty()) {
+		return match;
+	}
+	const char *begin = pool.bytes.data();
+	size_t position = 0;
+	while (position < pool.bytes.size()) {
+		auto hit = (const char *)memmem(begin + position, pool.bytes.size() - position, needle.data(), needle.size());
+		if (!hit) {
+			break;
+		}
+		size_t offset = hit - begin;
+		size_t code = std::upper_bound(pool.offsets.begin(), pool.offsets.end(), offset) - pool.offsets.begin() - 1;
+		if (offset + needle.size() <= pool.offsets[code + 1]) {
+			match.bitmap[code] = 1;
+			position = pool.offsets[code + 1];
+		}
+		else {
+			position = offset + 1;
+		}
+	}
+	return match;
+}
+
+codeMatch suffix(const stringPool &pool, std::string_view suffix) {
+	codeMatch match;
+	match.bitmap.assign(pool.size(), 0);
+	for (size_t code = 0; code < pool.size(); ++code) {
+		auto entry = pool.entry(code);
+		match.bitmap[code] = entry.size() >= suffix.size() && entry.substr(entry.size() - suffix.size()) == suffix;
+	}
+	return match;
+}
+
+/**
+	SQL LIKE: '%' matches any sequence, '_' any single character. Greedy with backtracking to the last '%'.
+*/
+bool like(std::string_view value, std::string_view pattern) {
+	size_t v = 0;
+	size_t p = 0;
+	size_t starP = std::string_view::npos;
+	size_t starV = 0;
+	while (v < value.size()) {
+		if (p < pattern.size() && (pattern[p] == '_' || (pattern[p] != '%' && pattern[p] == value[v]))) {
+			++v;
+			++p;
+		}
+		else if (p < pattern.size() && pattern[p] == '%') {
+			starP = p++;
+			starV = v;
+		}
+		else if (starP != std::string_view::npos) {
+			p = starP + 1;
+			v = ++starV;
+		}
+		else {
+			return false;
+		}
+	}
+	while (p < pattern.size() && pattern[p] == '%') {
+		++p;
+	}
+	return p == pattern.size();
+}
+
+/**
+	Entries matching a LIKE pattern:
+		- 'abc%' is a prefix, '%abc' a suffix and '%abc%' a contains search
+		- Otherwise the longest literal of the pattern is searched in the pool first,
+		  only the entries containing it are matched against the full pattern
+*/
+codeMatch like(const std::vector<std::string> &dictionary, const stringPool &pool, std::string_view pattern) {
+	auto isLiteral = [](std::string_view part) {
+		return part.find_first_of("%_") == std::string_view::npos;
+	};
+	if (pattern.size() >= 1 && pattern.back() == '%' && isLiteral(pattern.substr(0, pattern.size() - 1))) {
+		return prefix(dictionary, pattern.substr(0, pattern.size() - 1));
+	}
+	if (pattern.size() >= 1 && pattern.front() == '%' && isLiteral(pattern.substr(1))) {
+		return suffix(pool, pattern.substr(1));
+	}
+	if (pattern.size() >= 2 && pattern.front() == '%' && pattern.back() == '%' && isLiteral(pattern.substr(1, pattern.size() - 2))) {
+		return contains(pool, pattern.substr(1, pattern.size() - 2));
+	}
+	std::string_view longest;
+	size_t start = 0;
+	while (start <= pattern.size()) {
+		size_t end = std::min(pattern.find_first_of("%_", start), pattern.size());
+		if (end - start > longest.size()) {
+			longest = pattern.substr(start, end - start);
+		}
+		start = end + 1;
+	}
+	codeMatch match = contains(pool, longest);
+	for (size_t code = 0; code < match.bitmap.size(); ++code) {
+		if (match.bitmap[code]) {
+			match.bitmap[code] = like(pool.entry(code), pattern);
+		}
+	}
+	return match;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Counts the rows whose code matches. A code range is two comparisons per row, a bitmap one lookup,
+	both branch free so the compiler can vectorize the scan.
+*/
+template <typename C>
+size_t count_where_op(const std::pair<std::vector<std::string>, std::vector<C>> &compressed, const codeMatch &match) {
+	size_t count = 0;
+	if (match.bitmap.empty()) {
+		for (auto code : compressed.second) {
+			count += code >= match.first && code < match.second;
+		}
+	}
+	else {
+		const uint8_t *bitmap = match.bitmap.data();
+		for (auto code : compressed.second) {
+			count += bitmap[code];
+		}
+	}
+	return count;
+}
+
+/**
+	Indices of all rows whose code matches.
+*/
+template <typename C>
+std::vector<size_t> where_view(const std::pair<std::vector<std::string>, std::vector<C>> &compressed, const codeMatch &match) {
+	std::vector<size_t> rows;
+	for (size_t i = 0; i < compressed.second.size(); ++i) {
+		if (match.contains(compressed.second[i])) {
+			rows.push_back(i);
+		}
+	}
+	return rows;
+}
+
+template <typename C>
+std::vector<std::string> where_view_op(std::pair<std::vector<std::string>, std::vector<C>> &compressed, const codeMatch &match) {
+	return Dictionary::partial_decompress(compressed, where_view(compressed, match));
+}
+
+} // end namespace Pattern
@@ -0,0 +1,61 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "pattern.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::vector<std::string> column = {"Clerk#001", "Clerk#002", "Clerk#010", "Cleric", "special requests", "specialist", "no special request", "", "Clerk#001"};
+	auto compressedColumn = Dictionary::compress<std::string, uint8_t>(column);
+	auto pool = Pattern::pool(compressedColumn.first);
+	auto expected = [&column](std::function<bool (const std::string &)> predicate) {
+		return (size_t)std::count_if(column.begin(), column.end(), predicate);
+	};
+	std::cout << "#### TEST PREFIX ####" << std::endl;
+	{
+		auto match = Pattern::prefix(compressedColumn.first, "Clerk#00");
+		assert(match.bitmap.empty() && match.second - match.first == 2);
+		assert(Pattern::count_where_op(compressedColumn, match) == 3);
+		std::vector<size_t> expectedView = {0, 1, 8};
+		assert(Pattern::where_view(compressedColumn, match) == expectedView);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::prefix(compressedColumn.first, "Cler")) == 5);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::prefix(compressedColumn.first, "x")) == 0);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::prefix(compressedColumn.first, "")) == column.size());
+	}
+	std::cout << "#### TEST CONTAINS / SUFFIX ####" << std::endl;
+	{
+		assert(Pattern::count_where_op(compressedColumn, Pattern::contains(pool, "special")) == 3);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::contains(pool, "request")) == 2);
+		// "Cleric" + "Clerk#001" are adjacent in the pool, the hit across both entries does not count
+		assert(Pattern::count_where_op(compressedColumn, Pattern::contains(pool, "icClerk")) == 0);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::suffix(pool, "01")) == 2);
+		assert(Pattern::count_where_op(compressedColumn, Pattern::suffix(pool, "")) == column.size());
+	}
+	std::cout << "#### TEST LIKE ####" << std::endl;
+	{
+		assert(Pattern::like("special requests", "%special%requests%"));
+		assert(Pattern::like("Clerk#010", "Clerk#_1_"));
+		assert(!Pattern::like("Clerk#001", "Clerk#_1_"));
+		assert(Pattern::like("", "%"));
+		assert(!Pattern::like("abc", "ab"));
+		for (std::string pattern : {"Clerk%", "%ist", "%ecial%", "%special%requests%", "Clerk#0_1", "%e_u%", "_"}) {
+			auto match = Pattern::like(compressedColumn.first, pool, pattern);
+			assert(Pattern::count_where_op(compressedColumn, match) == expected([&pattern](const std::string &v) {
+				return Pattern::like(v, pattern);
+			}));
+		}
+		auto values = Pattern::where_view_op(compressedColumn, Pattern::like(compressedColumn.first, pool, "%special%requests%"));
+		std::vector<std::string> expectedValues = {"special requests"};
+		assert(values == expectedValues);
+	}
+	return 0;
+}
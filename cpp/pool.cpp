@@ -0,0 +1,327 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace Pool
+{
+
+/**
+	Tasks submitted without a node may run on any worker.
+*/
+const size_t ANY_NODE = std::numeric_limits<size_t>::max();
+
+/**
+	How benchmarks share the pool:
+		- Isolated: one benchmark task at a time, its timings are not disturbed by others (work inside the task may still be parallel)
+		- Throughput: all benchmark tasks at once, the suite finishes sooner
+*/
+enum class Mode {
+	Isolated,
+	Throughput
+};
+
+/**
+	CPUs of every NUMA node, cpus[node] lists the CPU numbers of node.
+*/
+struct topology {
+	std::vector<std::vector<size_t>> cpus;
+
+	size_t nodes() const { return cpus.size(); }
+};
+
+// ---------------------- NUMA ------------------ //
+
+/**
+	Parses a Linux CPU list such as "0-3,8-11".
+*/
+inline std::vector<size_t> parse_cpulist(const std::string &list) {
+	std::vector<size_t> cpus;
+	std::stringstream ranges(list);
+	std::string range;
+	while (std::getline(ranges, range, ',')) {
+		if (range.find_first_of("0123456789") == std::string::npos) {
+			continue;
+		}
+		auto dash = range.find('-');
+		size_t first = std::stoul(range.substr(0, dash));
+		size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+		for (size_t cpu = first; cpu <= last; ++cpu) {
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+/**
+	NUMA nodes from sysfs (root/node<N>/cpulist). Without sysfs a single node with all hardware threads.
+*/
+inline topology detect_topology(const std::string &root = "/sys/devices/system/node/") {
+	topology result;
+	for (size_t node = 0;; ++node) {
+		std::ifstream file(root + "node" + std::to_string(node) + "/cpulist");
+		std::string list;
+		if (!file || !std::getline(file, list)) {
+			break;
+		}
+		auto cpus = parse_cpulist(list);
+		if (!cpus.empty()) {
+			result.cpus.push_back(cpus);
+		}
+	}
+	if (result.cpus.empty()) {
+		result.cpus.emplace_back();
+		for (size_t cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu) {
+			result.cpus[0].push_back(cpu);
+		}
+	}
+	return result;
+}
+
+/**
+	Restricts the calling thread to the given CPUs. False if the kernel refuses (e.g. none of them is available).
+*/
+inline bool pin(const std::vector<size_t> &cpus) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (auto cpu : cpus) {
+		if (cpu < CPU_SETSIZE) {
+			CPU_SET(cpu, &set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// ---------------------- POOL ------------------ //
+
+/**
+	Work-stealing thread pool. Every worker owns a deque: it takes its own tasks from the back (most recent first,
+	still warm in its cache) and steals from the front of the others when it runs dry. Tasks submitted by a worker
+	go to its own deque, tasks from outside the pool are spread round robin.
+
+	With a NUMA topology of several nodes, worker i is pinned to the CPUs of node i % nodes. Tasks can be submitted
+	to a node, thieves look at the deques of their own node before crossing to another. Strict tasks never cross:
+	they wait in a separate deque that only the workers of their node take from (e.g. for first-touch placement).
+*/
+class ThreadPool
+{
+public:
+	ThreadPool(size_t threads = std::thread::hardware_concurrency()) : ThreadPool(threads, topology{{{}}}) { }
+
+	ThreadPool(size_t threads, const topology &numa) {
+		threads = std::max<size_t>(threads, 1);
+		size_t nodes = std::max<size_t>(numa.nodes(), 1);
+		nodeWorkers.resize(std::min(nodes, threads));
+		nodePending.resize(nodeWorkers.size(), 0);
+		for (size_t i = 0; i < threads; ++i) {
+			queues.push_back(std::make_unique<queue>());
+			workerNodes.push_back(i % nodeWorkers.size());
+			nodeWorkers[workerNodes[i]].push_back(i);
+		}
+		// Victims of every worker: itself, then its node, then the other nodes
+		for (size_t i = 0; i < threads; ++i) {
+			std::vector<size_t> order;
+			for (size_t n = 0; n < nodeWorkers.size(); ++n) {
+				const auto &candidates = nodeWorkers[(workerNodes[i] + n) % nodeWorkers.size()];
+				order.insert(order.end(), candidates.begin(), candidates.end());
+			}
+			std::stable_partition(order.begin(), order.end(), [i](size_t w) { return w == i; });
+			victims.push_back(order);
+		}
+		for (size_t i = 0; i < threads; ++i) {
+			std::vector<size_t> cpus = nodeWorkers.size() > 1 ? numa.cpus[workerNodes[i]] : std::vector<size_t>();
+			workers.emplace_back([this, i, cpus] {
+				if (!cpus.empty()) {
+					pin(cpus);
+				}
+				loop(i);
+			});
+		}
+	}
+
+	/**
+		Finishes all submitted tasks, then joins the workers.
+	*/
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto &worker : workers) {
+			worker.join();
+		}
+	}
+
+	size_t size() const { return workers.size(); }
+
+	/**
+		Nodes with at least one worker.
+	*/
+	size_t nodes() const { return nodeWorkers.size(); }
+
+	size_t node(size_t worker) const { return workerNodes[worker]; }
+
+	/**
+		Index of the calling worker, size() for threads outside the pool.
+	*/
+	size_t worker() const { return current == this ? self : size(); }
+
+	/**
+		Queues fn on a worker of node (any worker for ANY_NODE) and returns its future.
+		A strict task runs on a worker of its node, others may be stolen by any worker.
+	*/
+	template <typename F>
+	auto submit(F fn, size_t node = ANY_NODE, bool strict = false) -> std::future<decltype(fn())> {
+		using R = decltype(fn());
+		auto task = std::make_shared<std::packaged_task<R ()>>(std::move(fn));
+		auto future = task->get_future();
+		size_t target;
+		if (node != ANY_NODE) {
+			const auto &candidates = nodeWorkers[node % nodeWorkers.size()];
+			target = current == this && workerNodes[self] == node % nodeWorkers.size() ? self : candidates[next++ % candidates.size()];
+		}
+		else {
+			target = current == this ? self : next++ % queues.size();
+		}
+		strict = strict && node != ANY_NODE;
+		{
+			std::lock_guard<std::mutex> lock(queues[target]->mutex);
+			(strict ? queues[target]->nodeTasks : queues[target]->tasks).emplace_back([task] { (*task)(); });
+		}
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			++(strict ? nodePending[workerNodes[target]] : pending);
+		}
+		// Only workers of the node can take a strict task, the one woken up by notify_one might not be one of them
+		strict ? wake.notify_all() : wake.notify_one();
+		return future;
+	}
+
+	/**
+		Waits for a task of this pool. A worker runs other tasks meanwhile, so tasks may wait for the tasks they submitted.
+	*/
+	template <typename T>
+	T wait(std::future<T> &future) {
+		if (current == this) {
+			while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				if (!run_one(self)) {
+					std::this_thread::yield();
+				}
+			}
+		}
+		return future.get();
+	}
+
+private:
+	struct queue {
+		std::mutex mutex;
+		std::deque<std::function<void ()>> tasks;
+		// Strict tasks of the worker's node
+		std::deque<std::function<void ()>> nodeTasks;
+	};
+
+	/**
+		Runs one task, the newest of the own deques or the oldest of another (nearest node first, strict tasks
+		only from the own node). False if there is nothing to run.
+	*/
+	bool run_one(size_t index) {
+		std::function<void ()> task;
+		bool strict = false;
+		for (size_t i = 0; i < victims[index].size() && !task; ++i) {
+			auto &q = *queues[victims[index][i]];
+			bool sameNode = workerNodes[victims[index][i]] == workerNodes[index];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			for (auto *tasks : {&q.nodeTasks, &q.tasks}) {
+				if (tasks->empty() || (tasks == &q.nodeTasks && !sameNode)) {
+					continue;
+				}
+				if (i == 0) {
+					task = std::move(tasks->back());
+					tasks->pop_back();
+				}
+				else {
+					task = std::move(tasks->front());
+					tasks->pop_front();
+				}
+				strict = tasks == &q.nodeTasks;
+				break;
+			}
+		}
+		if (!task) {
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			--(strict ? nodePending[workerNodes[index]] : pending);
+		}
+		task();
+		return true;
+	}
+
+	void loop(size_t index) {
+		current = this;
+		self = index;
+		while (true) {
+			if (run_one(index)) {
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			size_t node = workerNodes[index];
+			wake.wait(lock, [this, node] { return stopping || pending > 0 || nodePending[node] > 0; });
+			if (stopping && pending == 0 && nodePending[node] == 0) {
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<queue>> queues;
+	std::vector<size_t> workerNodes;
+	std::vector<std::vector<size_t>> nodeWorkers;
+	std::vector<std::vector<size_t>> victims;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next{0};
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	// Submitted tasks not yet taken (strict ones per node), may briefly drop below 0 when a task is taken before it is counted
+	long pending = 0;
+	std::vector<long> nodePending;
+	bool stopping = false;
+
+	// The pool and deque of the calling thread, if it is a worker
+	inline static thread_local ThreadPool *current = nullptr;
+	inline static thread_local size_t self = 0;
+};
+
+/**
+	Calls fn(first, last) for consecutive chunks of [0, size) of at most grain elements, in parallel, and returns when all are done.
+*/
+template <typename F>
+void parallel_for(ThreadPool &pool, size_t size, size_t grain, F fn) {
+	grain = std::max<size_t>(grain, 1);
+	std::vector<std::future<void>> chunks;
+	for (size_t first = 0; first < size; first += grain) {
+		size_t last = std::min(size, first + grain);
+		chunks.push_back(pool.submit([&fn, first, last] { fn(first, last); }));
+	}
+	for (auto &chunk : chunks) {
+		pool.wait(chunk);
+	}
+}
+
+/**
+	parallel_for on pool, for algorithms that take a runner(size, grain, fn) such as Huffman::compress.
+*/
+inline auto runner(ThreadPool &pool) {
+	return [&pool](size_t size, size_t grain, auto fn) {
+		parallel_for(pool, size, grain, fn);
+	};
+}
+
+} // end namespace Pool
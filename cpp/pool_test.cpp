@@ -0,0 +1,130 @@
+#include <vector>
+#include <string>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "pool.cpp"
+
+/**
+	Tasks that submit and wait for their own subtasks.
+*/
+long fibonacci(Pool::ThreadPool &pool, int n) {
+	if (n < 2) {
+		return n;
+	}
+	auto left = pool.submit([&pool, n] { return fibonacci(pool, n - 1); });
+	long right = fibonacci(pool, n - 2);
+	return pool.wait(left) + right;
+}
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST SUBMIT ####" << std::endl;
+	{
+		Pool::ThreadPool pool(4);
+		assert(pool.size() == 4);
+		std::vector<std::future<size_t>> futures;
+		for (size_t i = 0; i < 100; ++i) {
+			futures.push_back(pool.submit([i] { return i * i; }));
+		}
+		for (size_t i = 0; i < futures.size(); ++i) {
+			assert(pool.wait(futures[i]) == i * i);
+		}
+		auto failing = pool.submit([]() -> int { throw std::invalid_argument("failing task"); });
+		bool thrown = false;
+		try {
+			pool.wait(failing);
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::cout << "#### TEST NESTED TASKS ####" << std::endl;
+	{
+		// A single worker has to run the subtasks while it waits for them
+		for (size_t threads : {1, 3}) {
+			Pool::ThreadPool pool(threads);
+			auto result = pool.submit([&pool] { return fibonacci(pool, 18); });
+			assert(pool.wait(result) == 2584);
+		}
+	}
+	std::cout << "#### TEST PARALLEL FOR ####" << std::endl;
+	{
+		Pool::ThreadPool pool(4);
+		std::vector<int> values(100003);
+		Pool::parallel_for(pool, values.size(), 1000, [&values](size_t first, size_t last) {
+			for (size_t i = first; i < last; ++i) {
+				values[i] += i % 7;
+			}
+		});
+		long expected = 0;
+		for (size_t i = 0; i < values.size(); ++i) {
+			expected += i % 7;
+		}
+		assert(std::accumulate(values.begin(), values.end(), 0L) == expected);
+		Pool::parallel_for(pool, 0, 1000, [](size_t first, size_t last) { assert(false); });
+	}
+	std::cout << "#### TEST NUMA ####" << std::endl;
+	{
+		std::vector<size_t> expected = {0, 1, 2, 3, 8, 10, 11};
+		assert(Pool::parse_cpulist("0-3,8,10-11\n") == expected);
+		assert(Pool::parse_cpulist("").empty());
+		auto fallback = Pool::detect_topology("/nonexistent/");
+		assert(fallback.nodes() == 1 && !fallback.cpus[0].empty());
+		auto detected = Pool::detect_topology();
+		assert(detected.nodes() >= 1);
+
+		// Two nodes on CPU 0: workers alternate between the nodes, tasks for a node run there unless stolen
+		Pool::topology numa{{{0}, {0}}};
+		Pool::ThreadPool pool(3, numa);
+		assert(pool.nodes() == 2 && pool.node(0) == 0 && pool.node(1) == 1 && pool.node(2) == 0);
+		assert(pool.worker() == pool.size());
+		std::vector<std::future<size_t>> futures;
+		for (size_t i = 0; i < 100; ++i) {
+			futures.push_back(pool.submit([&pool] { return pool.worker(); }, i % 2));
+		}
+		for (auto &future : futures) {
+			assert(pool.wait(future) < pool.size());
+		}
+
+		// Strict tasks are never stolen: node 0 workers stay idle while node 1 works through a long queue
+		std::vector<std::future<size_t>> strictFutures;
+		for (size_t i = 0; i < 1000; ++i) {
+			strictFutures.push_back(pool.submit([&pool] {
+				std::this_thread::yield();
+				return pool.node(pool.worker());
+			}, 1, true));
+		}
+		for (size_t i = 0; i < 100; ++i) {
+			strictFutures.push_back(pool.submit([&pool] { return pool.node(pool.worker()); }, i % 2, true));
+		}
+		for (size_t i = 0; i < strictFutures.size(); ++i) {
+			assert(pool.wait(strictFutures[i]) == (i < 1000 ? 1 : i % 2));
+		}
+		// A worker waiting for a strict task of another node leaves it to that node
+		auto nested = pool.submit([&pool] {
+			auto inner = pool.submit([&pool] { return pool.node(pool.worker()); }, 1, true);
+			return pool.wait(inner);
+		}, 0, true);
+		assert(pool.wait(nested) == 1);
+		Pool::ThreadPool fewerWorkers(2, Pool::topology{{{0}, {0}, {0}}});
+		assert(fewerWorkers.nodes() == 2);
+	}
+	std::cout << "#### TEST SHUTDOWN ####" << std::endl;
+	{
+		std::atomic<size_t> done{0};
+		{
+			Pool::ThreadPool pool(2);
+			for (int i = 0; i < 1000; ++i) {
+				pool.submit([&done] { ++done; });
+			}
+		}
+		assert(done == 1000);
+	}
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include <functional>
+#include <optional>
+#include <stdexcept>
+
+namespace Query
+{
+
+/**
+	A predicate on one compressed column:
+		- selectivity: estimated fraction of matching rows, decides the evaluation order
+		- select(): all matching rows in ascending order, scans the whole column
+		- refine(rows): the matching subset of rows (ascending), only looks at these rows
+	The compressed column is captured by reference and has to outlive the filter.
+*/
+struct filter {
+	std::string name;
+	double selectivity = 1;
+	std::function<std::vector<size_t> ()> select;
+	std::function<std::vector<size_t> (const std::vector<size_t> &)> refine;
+};
+
+/**
+	Late materialization of a column: the values of the given rows (ascending).
+*/
+template <typename D>
+using source = std::function<std::vector<D> (const std::vector<size_t> &)>;
+
+// ---------------------- INTERNAL ------------------ //
+
+/**
+	Filter on a Dictionary compressed column whose predicate was already evaluated per code (matches[code]).
+*/
+template <typename D, typename C>
+filter codeFilter(std::string name, const std::pair<std::vector<D>, std::vector<C>> &compressed, std::vector<uint8_t> matches, double selectivity) {
+	filter result;
+	result.name = name;
+	result.selectivity = selectivity;
+	result.select = [&compressed, matches]() {
+		std::vector<size_t> rows;
+		for (size_t i = 0; i < compressed.second.size(); ++i) {
+			if (matches[compressed.second[i]]) {
+				rows.push_back(i);
+			}
+		}
+		return rows;
+	};
+	result.refine = [&compressed, matches](const std::vector<size_t> &rows) {
+		std::vector<size_t> refined;
+		for (auto row : rows) {
+			if (matches[compressed.second[row]]) {
+				refined.push_back(row);
+			}
+		}
+		return refined;
+	};
+	return result;
+}
+
+/**
+	Values of the given rows (ascending) of a Huffman column. With pre-aggregates the row count of every block is known,
+	so only the blocks holding one of the rows are decoded.
+*/
+template <typename D, std::size_t SIZE>
+std::vector<D> huffmanGather(const Huffman::compressedData<D, SIZE> &column, const std::vector<size_t> &rows) {
+	auto reverseDictionary = Huffman::getReverseDictionary(column.dictionary);
+	std::vector<D> values;
+	values.reserve(rows.size());
+	size_t offset = 0;
+	size_t r = 0;
+	for (size_t i = 0; i < column.compressed.size() && r < rows.size(); ++i) {
+		if (!column.aggregates.empty() && rows[r] >= offset + column.aggregates[i].count) {
+			offset += column.aggregates[i].count;
+			continue;
+		}
+		auto block = Huffman::decompressBlock<D, SIZE>(column.compressed[i], reverseDictionary);
+		for (; r < rows.size() && rows[r] < offset + block.size(); ++r) {
+			values.push_back(block[rows[r] - offset]);
+		}
+		offset += block.size();
+	}
+	return values;
+}
+
+// ---------------------- FILTERS ------------------ //
+
+/**
+	Arbitrary predicate on a Dictionary compressed column, evaluated once per dictionary entry.
+	The selectivity is exact, from the code frequencies in the statistics.
+*/
+template <typename D, typename C>
+filter dictionary_filter(std::string name, std::pair<std::vector<D>, std::vector<C>> &compressed, const Statistics::columnStatistics<D> &stats,
+                         std::function<bool (D)> predicate) {
+	std::vector<uint8_t> matches(compressed.first.size());
+	for (size_t code = 0; code < matches.size(); ++code) {
+		matches[code] = predicate(compressed.first[code]);
+	}
+	return codeFilter(name, compressed, matches, Statistics::selectivity(compressed, stats, predicate));
+}
+
+/**
+	Value range [from, to) on a Dictionary compressed column: a code range, selectivity from the histogram.
+*/
+template <typename D, typename C>
+filter dictionary_range_filter(std::string name, std::pair<std::vector<D>, std::vector<C>> &compressed, const Statistics::columnStatistics<D> &stats,
+                               std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = Dictionary::code_range(compressed.first, from, to);
+	std::vector<uint8_t> matches(compressed.first.size(), 0);
+	std::fill(matches.begin() + first, matches.begin() + second, 1);
+	return codeFilter(name, compressed, matches, Statistics::estimate_selectivity_range(compressed, stats, from, to));
+}
+
+/**
+	Value range [from, to) on a Huffman column. The selectivity is estimated from the block bounds: blocks inside
+	the range count fully, blocks the range boundary falls into half. With pre-aggregates select() skips blocks
+	outside the range and takes blocks inside it without decoding them.
+*/
+template <typename D, std::size_t SIZE>
+filter huffman_range_filter(std::string name, const Huffman::compressedData<D, SIZE> &column, std::optional<D> from, std::optional<D> to) {
+	filter result;
+	result.name = name;
+	double estimated = 0;
+	for (const auto &bound : column.bounds) {
+		auto coverage = Huffman::block_coverage(bound, from, to);
+		estimated += coverage == Huffman::Coverage::Full ? 1 : (coverage == Huffman::Coverage::Partial ? 0.5 : 0);
+	}
+	result.selectivity = column.bounds.empty() ? 0 : estimated / column.bounds.size();
+	result.select = [&column, from, to]() {
+		auto reverseDictionary = Huffman::getReverseDictionary(column.dictionary);
+		std::vector<size_t> rows;
+		size_t offset = 0;
+		for (size_t i = 0; i < column.compressed.size(); ++i) {
+			auto coverage = Huffman::block_coverage(column.bounds[i], from, to);
+			if (!column.aggregates.empty() && coverage != Huffman::Coverage::Partial) {
+				size_t count = column.aggregates[i].count;
+				for (size_t row = offset; coverage == Huffman::Coverage::Full && row < offset + count; ++row) {
+					rows.push_back(row);
+				}
+				offset += count;
+				continue;
+			}
+			auto block = Huffman::decompressBlock<D, SIZE>(column.compressed[i], reverseDictionary);
+			for (size_t j = 0; j < block.size(); ++j) {
+				if ((!from || !(block[j] < *from)) && (!to || block[j] < *to)) {
+					rows.push_back(offset + j);
+				}
+			}
+			offset += block.size();
+		}
+		return rows;
+	};
+	result.refine = [&column, from, to](const std::vector<size_t> &rows) {
+		auto values = huffmanGather(column, rows);
+		std::vector<size_t> refined;
+		for (size_t r = 0; r < rows.size(); ++r) {
+			if ((!from || !(values[r] < *from)) && (!to || values[r] < *to)) {
+				refined.push_back(rows[r]);
+			}
+		}
+		return refined;
+	};
+	return result;
+}
+
+// ---------------------- SOURCES ------------------ //
+
+template <typename D, typename C>
+source<D> dictionary_source(std::pair<std::vector<D>, std::vector<C>> &compressed) {
+	return [&compressed](const std::vector<size_t> &rows) {
+		return Dictionary::partial_decompress(compressed, rows);
+	};
+}
+
+template <typename D>
+source<D> blocklocal_source(const BlockLocal::compressedData<D> &compressed) {
+	return [&compressed](const std::vector<size_t> &rows) {
+		return BlockLocal::partial_decompress(compressed, rows);
+	};
+}
+
+template <typename D, std::size_t SIZE>
+source<D> huffman_source(const Huffman::compressedData<D, SIZE> &column) {
+	return [&column](const std::vector<size_t> &rows) {
+		return huffmanGather(column, rows);
+	};
+}
+
+// ---------------------- PIPELINE ------------------ //
+
+/**
+	Evaluation order of the filters: ascending estimated selectivity, ties keep their given order.
+*/
+std::vector<filter> plan(std::vector<filter> filters) {
+	std::stable_sort(filters.begin(), filters.end(), [](const filter &a, const filter &b) {
+		return a.selectivity < b.selectivity;
+	});
+	return filters;
+}
+
+/**
+	Rows matching all filters (conjunction). The most selective filter scans its column,
+	every further filter only checks the rows selected so far.
+*/
+std::vector<size_t> where(const std::vector<filter> &filters) {
+	if (filters.empty()) {
+		throw std::invalid_argument("Query without filters");
+	}
+	auto ordered = plan(filters);
+	auto rows = ordered[0].select();
+	for (size_t i = 1; i < ordered.size() && !rows.empty(); ++i) {
+		rows = ordered[i].refine(rows);
+	}
+	return rows;
+}
+
+/**
+	Values of another column for the selected rows, decompressed only at these rows.
+*/
+template <typename D>
+std::vector<D> project(const source<D> &column, const std::vector<size_t> &rows) {
+	return column(rows);
+}
+
+template <typename D>
+double sum(const source<D> &column, const std::vector<size_t> &rows) {
+	double result = 0;
+	for (const auto &value : column(rows)) {
+		result += value;
+	}
+	return result;
+}
+
+template <typename D>
+double avg(const source<D> &column, const std::vector<size_t> &rows) {
+	return rows.empty() ? 0 : sum(column, rows) / rows.size();
+}
+
+} // end namespace Query
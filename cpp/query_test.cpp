@@ -0,0 +1,101 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <queue>
+#include <cassert>
+#include <cmath>
+#include <bitset>
+#include <algorithm>
+#include <numeric>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "blocklocal.cpp"
+#include "huffman.cpp"
+#include "statistics.cpp"
+#include "query.cpp"
+
+int main(int argc, char const *argv[])
+{
+	// SUM(price) WHERE day < 100 AND status = 'O' AND price >= 500
+	const size_t rows = 20000;
+	std::vector<int> day;
+	std::vector<std::string> status;
+	std::vector<int> price;
+	for (size_t i = 0; i < rows; ++i) {
+		day.push_back(i / 50);
+		status.push_back(i % 3 == 0 ? "F" : "O");
+		price.push_back((i * 7919) % 1000);
+	}
+	auto compressedDay = Dictionary::compress<int, uint16_t>(day);
+	auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+	auto dayStats = Statistics::compute(compressedDay);
+	auto statusStats = Statistics::compute(compressedStatus);
+	Huffman::compressedData<int, 64> compressedPrice;
+	auto compressedColumn = Huffman::compress<int, 64>(price, &compressedPrice.aggregates);
+	compressedPrice.dictionary = std::get<0>(compressedColumn);
+	compressedPrice.compressed = std::get<1>(compressedColumn);
+	compressedPrice.bounds = std::get<2>(compressedColumn);
+	auto blockLocalPrice = BlockLocal::compress(price, 1000);
+
+	std::vector<size_t> expectedRows;
+	double expectedSum = 0;
+	for (size_t i = 0; i < rows; ++i) {
+		if (day[i] < 100 && status[i] == "O" && price[i] >= 500) {
+			expectedRows.push_back(i);
+			expectedSum += price[i];
+		}
+	}
+	std::vector<Query::filter> filters = {
+		Query::dictionary_filter<std::string, uint8_t>("status", compressedStatus, statusStats, [](std::string v) { return v == "O"; }),
+		Query::huffman_range_filter<int, 64>("price", compressedPrice, 500, {}),
+		Query::dictionary_range_filter<int, uint16_t>("day", compressedDay, dayStats, {}, 100),
+	};
+	std::cout << "#### TEST PLAN ####" << std::endl;
+	{
+		auto ordered = Query::plan(filters);
+		assert(ordered[0].name == "day" && ordered[1].name == "price" && ordered[2].name == "status");
+		assert(std::abs(ordered[0].selectivity - 0.25) < 0.01);
+		assert(std::abs(ordered[2].selectivity - 2.0 / 3) < 0.01);
+	}
+	std::cout << "#### TEST FILTERS ####" << std::endl;
+	{
+		for (const auto &f : filters) {
+			auto selected = f.select();
+			assert(std::is_sorted(selected.begin(), selected.end()));
+			std::vector<size_t> all(rows);
+			std::iota(all.begin(), all.end(), 0);
+			assert(f.refine(all) == selected);
+		}
+		// Without pre-aggregates every block is decoded, the result stays the same
+		Huffman::compressedData<int, 64> withoutAggregates = compressedPrice;
+		withoutAggregates.aggregates.clear();
+		assert((Query::huffman_range_filter<int, 64>("price", withoutAggregates, 500, {}).select() == filters[1].select()));
+	}
+	std::cout << "#### TEST PIPELINE ####" << std::endl;
+	{
+		auto selected = Query::where(filters);
+		assert(selected == expectedRows);
+		assert(Query::sum(Query::huffman_source(compressedPrice), selected) == expectedSum);
+		assert(Query::sum(Query::blocklocal_source(blockLocalPrice), selected) == expectedSum);
+		auto days = Query::project(Query::dictionary_source(compressedDay), selected);
+		assert(days.size() == selected.size() && days.back() == day[selected.back()]);
+		assert(Query::avg(Query::huffman_source(compressedPrice), selected) == expectedSum / selected.size());
+
+		std::vector<Query::filter> none = {Query::dictionary_range_filter<int, uint16_t>("day", compressedDay, dayStats, 1000, {}), filters[0]};
+		assert(Query::where(none).empty());
+		bool thrown = false;
+		try {
+			Query::where({});
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	return 0;
+}
@@ -0,0 +1,223 @@
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+
+namespace RowGroup
+{
+
+const size_t DEFAULT_ROWS = 1 << 16;
+
+/**
+	Statistics of one segment, taken from its directory entry and its sorted dictionary, nothing is scanned.
+	min and max ignore NULLs. A segment that is NULL only has no min and max (see empty()).
+*/
+template <typename D>
+struct statistics {
+	size_t rowGroup = 0;
+	size_t rows = 0;
+	size_t nullCount = 0;
+	size_t distinct = 0;
+	D min = D();
+	D max = D();
+
+	bool empty() const { return nullCount == rows; }
+};
+
+/**
+	Overwrites NULL rows with the first non-NULL value of the column, so NULLs show up neither in the dictionary
+	nor in the statistics. The null bitmap stored with the segment masks them again.
+*/
+template <typename D>
+void fillNulls(std::vector<D> &values, const std::vector<uint8_t> &nulls) {
+	auto firstValue = std::find(nulls.begin(), nulls.end(), 0);
+	if (firstValue == nulls.end()) {
+		return;
+	}
+	D fill = values[firstValue - nulls.begin()];
+	for (size_t i = 0; i < nulls.size(); ++i) {
+		if (nulls[i]) {
+			values[i] = fill;
+		}
+	}
+}
+
+/**
+	Reads a .tbl file in row groups of at most rowsPerGroup rows and calls fn(rowGroup, table) for each of them.
+	Only the raw lines and the parsed columns of one row group are in memory at a time.
+	Returns the number of row groups.
+*/
+template <typename F>
+size_t forEachRowGroup(const std::string &filePath, const std::vector<Schema::field> &schema, size_t rowsPerGroup, size_t threads, F fn) {
+	std::ifstream infileStream(filePath);
+	if (!infileStream) {
+		throw std::invalid_argument("Cannot open " + filePath);
+	}
+	std::string buffer;
+	std::string row;
+	size_t rows = 0;
+	size_t rowGroup = 0;
+	auto flush = [&]() {
+		fn(rowGroup++, Schema::parse(buffer.data(), buffer.data() + buffer.size(), schema, threads));
+		buffer.clear();
+		rows = 0;
+	};
+	bool firstLine = true;
+	while (std::getline(infileStream, row)) {
+		if (firstLine) {
+			firstLine = false;
+			if (Schema::isHeader(row, schema)) {
+				continue;
+			}
+		}
+		if (row.empty()) {
+			continue;
+		}
+		buffer += row;
+		buffer += '\n';
+		if (++rows == rowsPerGroup) {
+			flush();
+		}
+	}
+	if (rows > 0) {
+		flush();
+	}
+	return rowGroup;
+}
+
+// ---------------------- COMPRESS ------------------ //
+
+/**
+	Streams a .tbl file into a column file. Every row group is Dictionary compressed into one independent
+	segment per column (one thread per column), so memory use is bounded by the row group size instead of
+	the table size. Returns the number of row groups.
+*/
+size_t compress(const std::string &filePath, const std::vector<Schema::field> &schema, const std::string &storePath,
+                size_t rowsPerGroup = DEFAULT_ROWS, size_t threads = 0) {
+	Storage::Writer writer(storePath);
+	size_t rowGroups = forEachRowGroup(filePath, schema, rowsPerGroup, threads, [&writer](size_t rowGroup, std::vector<Schema::typedColumn> table) {
+		std::vector<std::function<void(Storage::Writer &)>> segments(table.size());
+		std::vector<std::exception_ptr> errors(table.size());
+		std::vector<std::thread> workers;
+		for (size_t c = 0; c < table.size(); ++c) {
+			workers.emplace_back([&table, &segments, &errors, c, rowGroup]() {
+				try {
+					auto &column = table[c];
+					std::visit([&](auto &values) {
+						using D = typename std::decay_t<decltype(values)>::value_type;
+						fillNulls(values, column.nulls);
+						auto compressed = Dictionary::compress<D, uint32_t>(values);
+						segments[c] = [compressed = std::move(compressed), &column, rowGroup](Storage::Writer &w) {
+							w.addDictionaryColumn(column.description.name, compressed, rowGroup, column.nulls);
+						};
+					}, column.values);
+				}
+				catch (...) {
+					errors[c] = std::current_exception();
+				}
+			});
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+		for (auto &error : errors) {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+		// The writer appends sequentially, segments are written in column order
+		for (auto &segment : segments) {
+			segment(writer);
+		}
+	});
+	writer.close();
+	return rowGroups;
+}
+
+// ---------------------- READ ------------------ //
+
+/**
+	Calls fn(view) with the Dictionary view of entry `index`, typed with the code width it was stored with.
+*/
+template <typename D, typename F>
+auto withSegment(const Storage::File &file, size_t index, F fn) {
+	switch (file.entry(index).codeWidth) {
+	case 1: return fn(file.dictionaryColumn<D, uint8_t>(index));
+	case 2: return fn(file.dictionaryColumn<D, uint16_t>(index));
+	case 4: return fn(file.dictionaryColumn<D, uint32_t>(index));
+	default: return fn(file.dictionaryColumn<D, uint64_t>(index));
+	}
+}
+
+template <typename D>
+statistics<D> segmentStatistics(const Storage::File &file, size_t index) {
+	return withSegment<D>(file, index, [&file, index](const auto &view) {
+		statistics<D> result;
+		result.rowGroup = file.entry(index).rowGroup;
+		result.rows = view.rows;
+		result.nullCount = view.nullCount;
+		result.distinct = view.dictionary.size;
+		if (!result.empty()) {
+			result.min = D(view.dictionary[0]);
+			result.max = D(view.dictionary[view.dictionary.size - 1]);
+		}
+		return result;
+	});
+}
+
+/**
+	Decompresses all segments of a column in row group order. NULL rows hold an arbitrary value of their segment.
+*/
+template <typename D>
+std::vector<D> decompress(const Storage::File &file, const std::string &name) {
+	std::vector<D> decompressed;
+	for (auto index : file.segments(name)) {
+		withSegment<D>(file, index, [&decompressed](const auto &view) {
+			auto segment = Storage::decompress(view);
+			decompressed.insert(decompressed.end(), segment.begin(), segment.end());
+		});
+	}
+	return decompressed;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Counts the non-NULL values matching the predicate over all segments of a column.
+*/
+template <typename D, typename P>
+size_t count_where_op(const Storage::File &file, const std::string &name, P predicate) {
+	size_t count = 0;
+	for (auto index : file.segments(name)) {
+		count += withSegment<D>(file, index, [&predicate](const auto &view) {
+			return Storage::count_where_op(view, predicate);
+		});
+	}
+	return count;
+}
+
+/**
+	Counts the values in [from, to) over all segments of a column. Segments whose [min, max] does not overlap
+	the range are skipped without touching their codes, segments that lie completely inside are answered
+	from their row and NULL counts. Only the remaining segments are scanned.
+*/
+template <typename D>
+size_t count_where_op_range(const Storage::File &file, const std::string &name, std::optional<D> from, std::optional<D> to) {
+	size_t count = 0;
+	for (auto index : file.segments(name)) {
+		auto stats = segmentStatistics<D>(file, index);
+		if (stats.empty() || (from && stats.max < *from) || (to && !(stats.min < *to))) {
+			continue;
+		}
+		if ((!from || !(stats.min < *from)) && (!to || stats.max < *to)) {
+			count += stats.rows - stats.nullCount;
+			continue;
+		}
+		count += withSegment<D>(file, index, [&from, &to](const auto &view) {
+			return Storage::count_where_op_range(view, from, to);
+		});
+	}
+	return count;
+}
+
+} // end namespace RowGroup
@@ -0,0 +1,84 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <utility>
+#include <queue>
+#include <cassert>
+#include <bitset>
+#include <algorithm>
+#include <cstdio>
+#include "allocator.cpp"
+#include "date.cpp"
+#include "csv.h"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "huffman.cpp"
+#include "statistics.cpp"
+#include "storage.cpp"
+#include "schema.cpp"
+#include "rowgroup.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::string filePath = "/tmp/rowgroup_test.tbl";
+	std::string storeFile = "/tmp/rowgroup_test.tucol";
+	std::vector<Schema::field> schema = {
+		{"KEY", Schema::Type::Int, false},
+		{"PRICE", Schema::Type::Decimal, true},
+		{"STATUS", Schema::Type::String, false},
+	};
+	{
+		std::ofstream file(filePath);
+		file << "KEY|PRICE|STATUS\n";
+		for (int i = 0; i < 1050; ++i) {
+			file << i << "|" << (i % 100 == 5 ? "" : std::to_string(i % 40)) << "|" << (i < 500 ? "F" : "O") << "|\n";
+		}
+	}
+	std::cout << "#### TEST COMPRESS ####" << std::endl;
+	{
+		assert(RowGroup::compress(filePath, schema, storeFile, 100, 2) == 11);
+		Storage::File file(storeFile);
+		assert(file.columnCount() == 33);
+		auto segments = file.segments("KEY");
+		assert(segments.size() == 11);
+		for (size_t g = 0; g < segments.size(); ++g) {
+			auto stats = RowGroup::segmentStatistics<int32_t>(file, segments[g]);
+			assert(stats.rowGroup == g);
+			assert(stats.rows == (g < 10 ? 100 : 50));
+			assert(stats.nullCount == 0 && stats.distinct == stats.rows);
+			assert(stats.min == (int32_t)g * 100 && stats.max == (int32_t)(g * 100 + stats.rows - 1));
+		}
+		auto stats = RowGroup::segmentStatistics<float>(file, file.segments("PRICE")[0]);
+		assert(stats.nullCount == 1 && stats.distinct == 40 && stats.min == 0 && stats.max == 39);
+
+		std::vector<int32_t> keys(1050);
+		std::iota(keys.begin(), keys.end(), 0);
+		assert(RowGroup::decompress<int32_t>(file, "KEY") == keys);
+		auto statuses = RowGroup::decompress<std::string>(file, "STATUS");
+		assert(statuses.size() == 1050 && statuses[499] == "F" && statuses[500] == "O");
+	}
+	std::cout << "#### TEST OPS ####" << std::endl;
+	{
+		Storage::File file(storeFile);
+		assert(RowGroup::count_where_op_range<int32_t>(file, "KEY", 250, 730) == 480);
+		assert(RowGroup::count_where_op_range<int32_t>(file, "KEY", {}, 2000) == 1050);
+		assert(RowGroup::count_where_op_range<int32_t>(file, "KEY", 2000, {}) == 0);
+		// NULLs never match
+		assert(RowGroup::count_where_op_range<float>(file, "PRICE", {}, {}) == 1039);
+		size_t expected = 0;
+		for (int i = 0; i < 1050; ++i) {
+			expected += i % 100 != 5 && i % 40 >= 5 && i % 40 < 10;
+		}
+		assert(RowGroup::count_where_op_range<float>(file, "PRICE", 5.0f, 10.0f) == expected);
+		assert(RowGroup::count_where_op<float>(file, "PRICE", [](float v) { return v >= 5 && v < 10; }) == expected);
+		assert(RowGroup::count_where_op_range<std::string>(file, "STATUS", std::string("O"), {}) == 550);
+		assert(RowGroup::count_where_op<std::string>(file, "STATUS", [](std::string_view v) { return v == "F"; }) == 500);
+	}
+	std::remove(filePath.c_str());
+	std::remove(storeFile.c_str());
+	return 0;
+}
@@ -0,0 +1,291 @@
+#include <charconv>
+#include <exception>
+#include <numeric>
+#include <variant>
+
+namespace Schema
+{
+
+/**
+	Column types of a schema file and the buffers they are parsed into:
+		INT -> int32_t, BIGINT -> int64_t, DECIMAL -> float, DATE -> Date::date16, STRING -> std::string
+*/
+enum class Type {
+	Int,
+	BigInt,
+	Decimal,
+	Date,
+	String,
+};
+
+struct field {
+	std::string name;
+	Type type;
+	bool nullable;
+};
+
+using columnValues = std::variant<std::vector<int32_t>, std::vector<int64_t>, std::vector<float>, std::vector<Date::date16>, std::vector<std::string>>;
+
+struct typedColumn {
+	field description;
+	columnValues values;
+	// One byte per row (1 = NULL) for nullable columns, empty otherwise
+	std::vector<uint8_t> nulls;
+
+	size_t size() const {
+		return std::visit([](const auto &v) { return v.size(); }, values);
+	}
+};
+
+Type typeFromString(const std::string &type) {
+	if (type == "INT") return Type::Int;
+	if (type == "BIGINT") return Type::BigInt;
+	if (type == "DECIMAL") return Type::Decimal;
+	if (type == "DATE") return Type::Date;
+	if (type == "STRING") return Type::String;
+	throw std::invalid_argument("Unknown column type " + type);
+}
+
+/**
+	Reads a schema file. One column per line: NAME|TYPE|NULL or NAME|TYPE|NOT NULL.
+	Empty lines and lines starting with '#' are ignored.
+*/
+std::vector<field> fromFile(std::string filePath) {
+	std::ifstream infileStream(filePath);
+	if (!infileStream) {
+		throw std::invalid_argument("Cannot open schema " + filePath);
+	}
+	std::vector<field> schema;
+	std::string row;
+	while (std::getline(infileStream, row)) {
+		if (row.empty() || row[0] == '#') {
+			continue;
+		}
+		std::stringstream rowStream(row);
+		std::string name, type, nullable;
+		std::getline(rowStream, name, '|');
+		std::getline(rowStream, type, '|');
+		std::getline(rowStream, nullable, '|');
+		if (nullable != "NULL" && nullable != "NOT NULL") {
+			throw std::invalid_argument("Expected NULL or NOT NULL for column " + name + " in " + filePath);
+		}
+		schema.push_back(field{name, typeFromString(type), nullable == "NULL"});
+	}
+	return schema;
+}
+
+std::vector<std::string> names(const std::vector<field> &schema) {
+	std::vector<std::string> header;
+	for (const auto &f : schema) {
+		header.push_back(f.name);
+	}
+	return header;
+}
+
+const typedColumn &column(const std::vector<typedColumn> &table, const std::string &name) {
+	for (const auto &c : table) {
+		if (c.description.name == name) {
+			return c;
+		}
+	}
+	throw std::invalid_argument("No column named " + name);
+}
+
+// ---------------------- PARSERS ------------------ //
+
+template <typename T>
+T parseInteger(std::string_view cell) {
+	T value = 0;
+	auto [end, error] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+	if (error != std::errc() || end != cell.data() + cell.size()) {
+		throw std::invalid_argument("Cannot convert " + std::string(cell) + " to integer");
+	}
+	return value;
+}
+
+/**
+	Parses [-]digits[.digits] as fixed point and converts once, no locale or stream involved.
+*/
+float parseDecimal(std::string_view cell) {
+	static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+	size_t i = 0;
+	bool negative = false;
+	if (i < cell.size() && (cell[i] == '-' || cell[i] == '+')) {
+		negative = cell[i] == '-';
+		++i;
+	}
+	int64_t mantissa = 0;
+	size_t digits = 0;
+	size_t scale = 0;
+	bool fraction = false;
+	for (; i < cell.size(); ++i) {
+		if (cell[i] == '.' && !fraction) {
+			fraction = true;
+		}
+		else if (cell[i] >= '0' && cell[i] <= '9' && digits < 18) {
+			mantissa = mantissa * 10 + (cell[i] - '0');
+			++digits;
+			scale += fraction;
+		}
+		else {
+			break;
+		}
+	}
+	if (digits == 0 || i != cell.size()) {
+		throw std::invalid_argument("Cannot convert " + std::string(cell) + " to decimal");
+	}
+	double value = (double)mantissa / powers[scale];
+	return (float)(negative ? -value : value);
+}
+
+template <typename T>
+void parseCell(std::string_view cell, T &out) {
+	if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+		out = parseInteger<T>(cell);
+	}
+	else if constexpr (std::is_same_v<T, float>) {
+		out = parseDecimal(cell);
+	}
+	else if constexpr (std::is_same_v<T, Date::date16>) {
+		out = Date::parse<uint16_t>(cell.data(), cell.size());
+	}
+	else {
+		out.assign(cell.data(), cell.size());
+	}
+}
+
+columnValues makeValues(Type type, size_t rows) {
+	switch (type) {
+	case Type::Int: return std::vector<int32_t>(rows);
+	case Type::BigInt: return std::vector<int64_t>(rows);
+	case Type::Decimal: return std::vector<float>(rows);
+	case Type::Date: return std::vector<Date::date16>(rows);
+	default: return std::vector<std::string>(rows);
+	}
+}
+
+// ---------------------- LOAD ------------------ //
+
+/**
+	Calls fn(line) for every non-empty line in [begin, end).
+*/
+template <typename F>
+void forEachLine(const char *begin, const char *end, F fn) {
+	while (begin < end) {
+		const char *lineEnd = std::find(begin, end, '\n');
+		if (lineEnd > begin) {
+			fn(begin, lineEnd);
+		}
+		begin = lineEnd + 1;
+	}
+}
+
+/**
+	True if the line lists the schema's column names (with or without a trailing '|').
+*/
+bool isHeader(std::string_view line, const std::vector<field> &schema) {
+	std::string expected;
+	for (size_t i = 0; i < schema.size(); ++i) {
+		expected += (i > 0 ? "|" : "") + schema[i].name;
+	}
+	return line == expected || line == expected + "|";
+}
+
+/**
+	Parses the rows in [begin, end) straight into typed, pre-sized column buffers:
+		1. Split the rows into one chunk per thread at line boundaries (see CSV::toColumnViews).
+		2. Count the rows of every chunk in parallel, so every chunk knows its first row.
+		3. Allocate every column once with the total row count.
+		4. Parse every chunk in parallel directly into its rows, without intermediate strings.
+*/
+std::vector<typedColumn> parse(const char *begin, const char *end, const std::vector<field> &schema, size_t threads = 0) {
+	if (threads == 0) {
+		threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+	auto chunks = CSV::splitChunks(begin, end, threads);
+
+	auto runParallel = [&chunks](auto fn) {
+		std::vector<std::thread> workers;
+		std::vector<std::exception_ptr> errors(chunks.size());
+		for (size_t c = 0; c < chunks.size(); ++c) {
+			workers.emplace_back([&fn, &errors, c]() {
+				try {
+					fn(c);
+				}
+				catch (...) {
+					errors[c] = std::current_exception();
+				}
+			});
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+		for (auto &error : errors) {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	};
+
+	std::vector<size_t> firstRow(chunks.size() + 1, 0);
+	runParallel([&chunks, &firstRow](size_t c) {
+		size_t rows = 0;
+		forEachLine(chunks[c].first, chunks[c].second, [&rows](const char *, const char *) {
+			++rows;
+		});
+		firstRow[c + 1] = rows;
+	});
+	std::partial_sum(firstRow.begin(), firstRow.end(), firstRow.begin());
+	size_t rows = firstRow.back();
+
+	std::vector<typedColumn> table;
+	for (const auto &f : schema) {
+		typedColumn column{f, makeValues(f.type, rows), {}};
+		if (f.nullable) {
+			column.nulls.assign(rows, 0);
+		}
+		table.push_back(std::move(column));
+	}
+
+	runParallel([&chunks, &firstRow, &table](size_t c) {
+		size_t row = firstRow[c];
+		forEachLine(chunks[c].first, chunks[c].second, [&row, &table](const char *lineBegin, const char *lineEnd) {
+			const char *cell = lineBegin;
+			for (auto &column : table) {
+				const char *separator = cell <= lineEnd ? CSV::findSeparator(cell, lineEnd, '|', '\n') : lineEnd;
+				std::string_view value(cell, cell <= lineEnd ? separator - cell : 0);
+				if (value.empty() && column.description.nullable) {
+					column.nulls[row] = 1;
+				}
+				else if (value.empty() && column.description.type != Type::String) {
+					throw std::invalid_argument("Empty value in NOT NULL column " + column.description.name);
+				}
+				else {
+					std::visit([&value, row](auto &values) {
+						parseCell(value, values[row]);
+					}, column.values);
+				}
+				cell = separator + 1;
+			}
+			++row;
+		});
+	});
+	return table;
+}
+
+/**
+	Maps a .tbl file and parses it with parse().
+	A first line equal to the schema's column names is treated as header and skipped.
+*/
+std::vector<typedColumn> load(std::string filePath, const std::vector<field> &schema, size_t threads = 0) {
+	CSV::MappedFile file(filePath);
+	const char *begin = file.data();
+	const char *end = file.data() + file.size();
+	const char *headerEnd = std::find(begin, end, '\n');
+	if (isHeader(std::string_view(begin, headerEnd - begin), schema)) {
+		begin = headerEnd < end ? headerEnd + 1 : end;
+	}
+	return parse(begin, end, schema, threads);
+}
+
+} // end namespace Schema
@@ -0,0 +1,80 @@
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdio>
+#include "date.cpp"
+#include "csv.h"
+#include "schema.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::string schemaPath = "/tmp/schema_test.schema";
+	std::string filePath = "/tmp/schema_test.tbl";
+	{
+		std::ofstream schema(schemaPath);
+		schema << "# test table\n";
+		schema << "KEY|INT|NOT NULL\nBIG|BIGINT|NOT NULL\nPRICE|DECIMAL|NULL\nDAY|DATE|NOT NULL\nNAME|STRING|NOT NULL\n";
+		std::ofstream file(filePath);
+		file << "KEY|BIG|PRICE|DAY|NAME\n";
+		for (int i = 0; i < 1000; ++i) {
+			file << i << "|" << i * 10000000000LL << "|" << (i == 7 ? "" : std::to_string(i) + ".25") << "|1996-01-02|name " << i << "|\n";
+		}
+	}
+	std::cout << "#### TEST SCHEMA ####" << std::endl;
+	auto schema = Schema::fromFile(schemaPath);
+	{
+		assert(schema.size() == 5);
+		assert(schema[2].type == Schema::Type::Decimal && schema[2].nullable);
+		assert(schema[4].type == Schema::Type::String && !schema[4].nullable);
+		std::vector<std::string> expectedNames = {"KEY", "BIG", "PRICE", "DAY", "NAME"};
+		assert(Schema::names(schema) == expectedNames);
+	}
+	std::cout << "#### TEST LOAD ####" << std::endl;
+	for (size_t threads : {1, 3, 8}) {
+		auto table = Schema::load(filePath, schema, threads);
+		assert(table.size() == 5);
+		assert(table[0].size() == 1000);
+		auto &keys = std::get<std::vector<int32_t>>(table[0].values);
+		auto &bigs = std::get<std::vector<int64_t>>(table[1].values);
+		auto &prices = std::get<std::vector<float>>(table[2].values);
+		auto &days = std::get<std::vector<Date::date16>>(table[3].values);
+		auto &names = std::get<std::vector<std::string>>(Schema::column(table, "NAME").values);
+		for (int i = 0; i < 1000; ++i) {
+			assert(keys[i] == i);
+			assert(bigs[i] == i * 10000000000LL);
+			assert(table[2].nulls[i] == (i == 7));
+			assert(i == 7 || prices[i] == std::stof(std::to_string(i) + ".25"));
+			assert(days[i] == Date::parse<uint16_t>("1996-01-02"));
+			assert(names[i] == "name " + std::to_string(i));
+		}
+	}
+	std::cout << "#### TEST PARSERS ####" << std::endl;
+	{
+		assert(Schema::parseDecimal("-12.5") == -12.5f);
+		assert(Schema::parseDecimal("173665.47") == std::stof("173665.47"));
+		assert(Schema::parseInteger<int32_t>("-42") == -42);
+		for (auto cell : {"", "1.2.3", "12a", "-"}) {
+			bool thrown = false;
+			try {
+				Schema::parseDecimal(cell);
+			}
+			catch (const std::invalid_argument &e) {
+				thrown = true;
+			}
+			assert(thrown);
+		}
+		bool thrown = false;
+		try {
+			Schema::parseInteger<int32_t>("1 ");
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::remove(schemaPath.c_str());
+	std::remove(filePath.c_str());
+	return 0;
+}
@@ -0,0 +1,104 @@
+#include <functional>
+#include <optional>
+
+namespace Shared
+{
+
+/**
+	Shared scans answer a batch of queries on one column with a single pass over the compressed data.
+	The pass only counts how often every symbol (dictionary code or Huffman code word) occurs, each query is then
+	answered from these counts: its predicate is evaluated once per symbol and never per row. The column is read
+	once, however many queries the batch holds.
+*/
+
+/**
+	WHERE clause of a query, an empty function selects all rows.
+*/
+template <typename D>
+using predicate = std::function<bool (D)>;
+
+/**
+	All aggregates of one query over its matching rows. sum is only filled for arithmetic columns.
+*/
+template <typename D>
+struct answer {
+	size_t count = 0;
+	double sum = 0;
+	std::optional<D> min;
+	std::optional<D> max;
+
+	double avg() const { return count == 0 ? 0 : sum / count; }
+};
+
+// ---------------------- INTERNAL ------------------ //
+
+/**
+	Answers every predicate from the number of rows per symbol.
+*/
+template <typename D>
+std::vector<answer<D>> answer_all(const std::vector<D> &symbols, const std::vector<size_t> &counts, const std::vector<predicate<D>> &predicates) {
+	std::vector<answer<D>> answers(predicates.size());
+	for (size_t s = 0; s < symbols.size(); ++s) {
+		if (counts[s] == 0) {
+			continue;
+		}
+		const auto &value = symbols[s];
+		for (size_t q = 0; q < predicates.size(); ++q) {
+			if (predicates[q] && !predicates[q](value)) {
+				continue;
+			}
+			auto &a = answers[q];
+			a.count += counts[s];
+			if constexpr (std::is_arithmetic_v<D>) {
+				a.sum += (double)value * counts[s];
+			}
+			if (!a.min || value < *a.min) {
+				a.min = value;
+			}
+			if (!a.max || *a.max < value) {
+				a.max = value;
+			}
+		}
+	}
+	return answers;
+}
+
+// ---------------------- SCANS ------------------ //
+
+/**
+	One pass over the codes of a Dictionary compressed column.
+*/
+template <typename D, typename C>
+std::vector<answer<D>> scan(const std::pair<std::vector<D>, std::vector<C>> &compressed, const std::vector<predicate<D>> &predicates) {
+	std::vector<size_t> counts(compressed.first.size(), 0);
+	for (auto code : compressed.second) {
+		++counts[code];
+	}
+	return answer_all(compressed.first, counts, predicates);
+}
+
+/**
+	One pass over the blocks of a Huffman column. Blocks are decoded into symbol numbers instead of values,
+	so no value is copied (or hashed) per row.
+*/
+template <typename D, std::size_t SIZE>
+std::vector<answer<D>> scan(const Huffman::compressedData<D, SIZE> &column, const std::vector<predicate<D>> &predicates) {
+	std::vector<D> symbols;
+	std::unordered_map<std::bitset<SIZE>, uint32_t> reverseDictionary;
+	for (const auto &[value, code] : column.dictionary) {
+		reverseDictionary[code] = symbols.size();
+		symbols.push_back(value);
+	}
+	std::vector<size_t> counts(symbols.size(), 0);
+	std::vector<uint32_t> decoded;
+	for (const auto &block : column.compressed) {
+		decoded.clear();
+		Huffman::decompressBlock(block, reverseDictionary, decoded);
+		for (auto symbol : decoded) {
+			++counts[symbol];
+		}
+	}
+	return answer_all(symbols, counts, predicates);
+}
+
+} // end namespace Shared
@@ -0,0 +1,102 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <queue>
+#include <cmath>
+#include <cassert>
+#include <bitset>
+#include <algorithm>
+#include "allocator.cpp"
+#include "date.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "huffman.cpp"
+#include "shared.cpp"
+
+/**
+	The same queries one scan each, over the uncompressed column.
+*/
+template <typename D>
+std::vector<Shared::answer<D>> expectedAnswers(const std::vector<D> &column, const std::vector<Shared::predicate<D>> &predicates) {
+	std::vector<Shared::answer<D>> answers;
+	for (const auto &predicate : predicates) {
+		Shared::answer<D> a;
+		for (const auto &value : column) {
+			if (predicate && !predicate(value)) {
+				continue;
+			}
+			++a.count;
+			if constexpr (std::is_arithmetic_v<D>) {
+				a.sum += value;
+			}
+			a.min = a.min ? std::min(*a.min, value) : value;
+			a.max = a.max ? std::max(*a.max, value) : value;
+		}
+		answers.push_back(a);
+	}
+	return answers;
+}
+
+template <typename D>
+void assertAnswers(const std::vector<Shared::answer<D>> &answers, const std::vector<Shared::answer<D>> &expected) {
+	assert(answers.size() == expected.size());
+	for (size_t q = 0; q < answers.size(); ++q) {
+		assert(answers[q].count == expected[q].count);
+		assert(answers[q].sum == expected[q].sum);
+		assert(answers[q].min == expected[q].min);
+		assert(answers[q].max == expected[q].max);
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	std::vector<int> prices;
+	std::vector<std::string> status;
+	for (int i = 0; i < 5000; ++i) {
+		prices.push_back((i * 37) % 1000);
+		status.push_back(i % 3 == 0 ? "O" : (i % 3 == 1 ? "F" : "P"));
+	}
+	std::vector<Shared::predicate<int>> priceQueries = {
+		{},
+		[](int v) { return v < 500; },
+		[](int v) { return v % 7 == 0; },
+		[](int v) { return v > 1000; },
+	};
+	std::vector<Shared::predicate<std::string>> statusQueries = {
+		[](std::string v) { return v == "O"; },
+		[](std::string v) { return v != "O"; },
+	};
+
+	std::cout << "#### TEST DICTIONARY ####" << std::endl;
+	{
+		auto compressedPrices = Dictionary::compress<int, uint16_t>(prices);
+		auto answers = Shared::scan(compressedPrices, priceQueries);
+		assertAnswers(answers, expectedAnswers(prices, priceQueries));
+		assert(answers[3].count == 0 && !answers[3].min && answers[3].avg() == 0);
+
+		auto compressedStatus = Dictionary::compress<std::string, uint8_t>(status);
+		auto statusAnswers = Shared::scan(compressedStatus, statusQueries);
+		assertAnswers(statusAnswers, expectedAnswers(status, statusQueries));
+		assert(statusAnswers[0].count == 1667 && *statusAnswers[1].min == "F");
+		assert(Shared::scan(compressedStatus, std::vector<Shared::predicate<std::string>>()).empty());
+	}
+	std::cout << "#### TEST HUFFMAN ####" << std::endl;
+	{
+		Huffman::compressedData<int, 64> priceData;
+		auto compressedPrices = Huffman::compress<int, 64>(prices);
+		priceData.dictionary = std::get<0>(compressedPrices);
+		priceData.compressed = std::get<1>(compressedPrices);
+		assertAnswers(Shared::scan(priceData, priceQueries), expectedAnswers(prices, priceQueries));
+
+		Huffman::compressedData<std::string, 64> statusData;
+		auto compressedStatus = Huffman::compress<std::string, 64>(status);
+		statusData.dictionary = std::get<0>(compressedStatus);
+		statusData.compressed = std::get<1>(compressedStatus);
+		assertAnswers(Shared::scan(statusData, statusQueries), expectedAnswers(status, statusQueries));
+	}
+	return 0;
+}
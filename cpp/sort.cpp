@@ -0,0 +1,126 @@
+#include <numeric>
+#include <queue>
+
+namespace Sort
+{
+
+/**
+	Dictionaries with at most this many entries are sorted with one counting pass (a single radix digit),
+	larger ones with a comparison sort on the codes.
+*/
+const size_t COUNTING_MAX = size_t(1) << 16;
+
+// ---------------------- INTERNAL ------------------ //
+
+/**
+	Number of rows per code.
+*/
+template <typename C>
+std::vector<size_t> histogram(const std::vector<C> &codes, size_t domain) {
+	std::vector<size_t> counts(domain, 0);
+	for (auto code : codes) {
+		++counts[code];
+	}
+	return counts;
+}
+
+/**
+	Position of code in the requested order: codes are order preserving, descending order just mirrors them.
+*/
+inline size_t rank(size_t code, size_t domain, bool descending) {
+	return descending ? domain - 1 - code : code;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	ORDER BY the column: row positions sorted by value, ties in row order. Only codes are compared,
+	the dictionary is sorted so their order is the order of the values.
+*/
+template <typename D, typename C>
+std::vector<size_t> order_by(const std::pair<std::vector<D>, std::vector<C>> &compressed, bool descending = false) {
+	const auto &codes = compressed.second;
+	size_t domain = compressed.first.size();
+	std::vector<size_t> rows(codes.size());
+	if (domain <= COUNTING_MAX) {
+		auto counts = histogram(codes, domain);
+		std::vector<size_t> offsets(domain, 0);
+		size_t offset = 0;
+		for (size_t r = 0; r < domain; ++r) {
+			size_t code = rank(r, domain, descending);
+			offsets[code] = offset;
+			offset += counts[code];
+		}
+		for (size_t row = 0; row < codes.size(); ++row) {
+			rows[offsets[codes[row]]++] = row;
+		}
+	}
+	else {
+		std::iota(rows.begin(), rows.end(), 0);
+		std::stable_sort(rows.begin(), rows.end(), [&codes, descending](size_t a, size_t b) {
+			return descending ? codes[b] < codes[a] : codes[a] < codes[b];
+		});
+	}
+	return rows;
+}
+
+/**
+	ORDER BY ... LIMIT k: the first k rows of order_by(), without sorting the column.
+		- Narrow dictionaries: a histogram gives the code of the k-th row, one more pass collects all rows before it
+		  and as many rows of that code as needed.
+		- Wide dictionaries: heap-select of the k best (code, row) pairs.
+*/
+template <typename D, typename C>
+std::vector<size_t> top_k(const std::pair<std::vector<D>, std::vector<C>> &compressed, size_t k, bool descending = true) {
+	const auto &codes = compressed.second;
+	size_t domain = compressed.first.size();
+	k = std::min(k, codes.size());
+	if (k == 0) {
+		return {};
+	}
+	std::vector<std::pair<size_t, size_t>> selected;
+	selected.reserve(k);
+	if (domain <= COUNTING_MAX) {
+		auto counts = histogram(codes, domain);
+		size_t threshold = 0;
+		size_t before = 0;
+		while (before + counts[rank(threshold, domain, descending)] < k) {
+			before += counts[rank(threshold, domain, descending)];
+			++threshold;
+		}
+		size_t ties = k - before;
+		for (size_t row = 0; row < codes.size(); ++row) {
+			size_t r = rank(codes[row], domain, descending);
+			if (r < threshold || (r == threshold && ties > 0)) {
+				ties -= r == threshold;
+				selected.emplace_back(r, row);
+			}
+		}
+	}
+	else {
+		// Max-heap on (rank, row): the top is the worst of the k best so far
+		std::priority_queue<std::pair<size_t, size_t>> heap;
+		for (size_t row = 0; row < codes.size(); ++row) {
+			std::pair<size_t, size_t> entry(rank(codes[row], domain, descending), row);
+			if (heap.size() < k) {
+				heap.push(entry);
+			}
+			else if (entry < heap.top()) {
+				heap.pop();
+				heap.push(entry);
+			}
+		}
+		for (; !heap.empty(); heap.pop()) {
+			selected.push_back(heap.top());
+		}
+	}
+	std::sort(selected.begin(), selected.end());
+	std::vector<size_t> rows;
+	rows.reserve(selected.size());
+	for (const auto &[r, row] : selected) {
+		rows.push_back(row);
+	}
+	return rows;
+}
+
+} // end namespace Sort
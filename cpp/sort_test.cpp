@@ -0,0 +1,69 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "sort.cpp"
+
+template <typename D>
+std::vector<size_t> expectedOrder(const std::vector<D> &column, bool descending) {
+	std::vector<size_t> rows(column.size());
+	std::iota(rows.begin(), rows.end(), 0);
+	std::stable_sort(rows.begin(), rows.end(), [&column, descending](size_t a, size_t b) {
+		return descending ? column[b] < column[a] : column[a] < column[b];
+	});
+	return rows;
+}
+
+int main(int argc, char const *argv[])
+{
+	std::cout << "#### TEST ORDER BY ####" << std::endl;
+	{
+		std::vector<float> narrow;
+		std::vector<int> wide;
+		for (int i = 0; i < 100000; ++i) {
+			narrow.push_back((i * 7919) % 997 / 4.0f);
+			wide.push_back((i * 7919) % 90001);
+		}
+		auto compressedNarrow = Dictionary::compress<float, uint16_t>(narrow);
+		auto compressedWide = Dictionary::compress<int, uint32_t>(wide);
+		assert(compressedWide.first.size() > Sort::COUNTING_MAX);
+		for (bool descending : {false, true}) {
+			assert(Sort::order_by(compressedNarrow, descending) == expectedOrder(narrow, descending));
+			assert(Sort::order_by(compressedWide, descending) == expectedOrder(wide, descending));
+		}
+		auto rows = Sort::order_by(compressedNarrow);
+		auto sorted = Dictionary::partial_decompress(compressedNarrow, rows);
+		assert(std::is_sorted(sorted.begin(), sorted.end()));
+	}
+	std::cout << "#### TEST TOP K ####" << std::endl;
+	{
+		std::vector<int> narrow;
+		std::vector<int> wide;
+		for (int i = 0; i < 100000; ++i) {
+			narrow.push_back(i % 50);
+			wide.push_back((i * 7919) % 90001);
+		}
+		auto compressedNarrow = Dictionary::compress<int, uint8_t>(narrow);
+		auto compressedWide = Dictionary::compress<int, uint32_t>(wide);
+		for (size_t k : {0, 1, 10, 2001, 100000, 200000}) {
+			for (bool descending : {false, true}) {
+				auto expectedNarrow = expectedOrder(narrow, descending);
+				expectedNarrow.resize(std::min(k, narrow.size()));
+				assert(Sort::top_k(compressedNarrow, k, descending) == expectedNarrow);
+				auto expectedWide = expectedOrder(wide, descending);
+				expectedWide.resize(std::min(k, wide.size()));
+				assert(Sort::top_k(compressedWide, k, descending) == expectedWide);
+			}
+		}
+	}
+	return 0;
+}
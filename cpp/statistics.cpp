@@ -0,0 +1,197 @@
+#include <optional>
+#include <type_traits>
+
+namespace Statistics
+{
+
+const size_t HISTOGRAM_BUCKETS = 64;
+
+/**
+	where_view_op gathers the matching rows one by one, where_copy_op copies the matching codes and
+	decompresses them sequentially. Above this fraction of matching rows the sequential decompress wins.
+*/
+const double COPY_SELECTIVITY = 0.25;
+
+/**
+	Equi-depth histogram over the code space: bucket b covers the codes [bounds[b], bounds[b + 1])
+	and holds counts[b] rows. Buckets hold about the same number of rows, so dense value ranges get narrow buckets.
+*/
+struct histogram {
+	std::vector<uint64_t> bounds;
+	std::vector<uint64_t> counts;
+};
+
+/**
+	Statistics of a Dictionary compressed column, all computed with one counting pass over the attribute vector.
+	cumulative[code] is the number of non-NULL rows with a smaller code, so the frequency of a code and
+	the number of rows in a code range are one subtraction each.
+*/
+template <typename D>
+struct columnStatistics {
+	size_t rows = 0;
+	size_t nullCount = 0;
+	size_t distinct = 0;
+	D min = D();
+	D max = D();
+	// Sum of all non-NULL values, arithmetic types only
+	double sum = 0;
+	std::vector<uint64_t> cumulative;
+	histogram buckets;
+
+	size_t frequency(size_t code) const { return cumulative[code + 1] - cumulative[code]; }
+	size_t count(size_t first, size_t second) const { return cumulative[second] - cumulative[first]; }
+};
+
+// ---------------------- BUILD ------------------ //
+
+/**
+	Per-code counts as prefix sums (size distinct + 1). Rows flagged in nulls (one byte per row) are not counted.
+*/
+template <typename C>
+std::vector<uint64_t> countCodes(const std::vector<C> &codes, size_t distinct, const std::vector<uint8_t> &nulls = {}) {
+	std::vector<uint64_t> cumulative(distinct + 1, 0);
+	for (auto code : codes) {
+		++cumulative[code + 1];
+	}
+	for (size_t i = 0; i < nulls.size(); ++i) {
+		cumulative[codes[i] + 1] -= nulls[i];
+	}
+	for (size_t code = 1; code < cumulative.size(); ++code) {
+		cumulative[code] += cumulative[code - 1];
+	}
+	return cumulative;
+}
+
+/**
+	Splits the code space into at most `buckets` ranges holding about the same number of rows.
+*/
+histogram equiDepth(const std::vector<uint64_t> &cumulative, size_t buckets = HISTOGRAM_BUCKETS) {
+	histogram result;
+	size_t distinct = cumulative.size() - 1;
+	uint64_t total = cumulative.back();
+	result.bounds.push_back(0);
+	for (size_t b = 1; b < buckets && total > 0; ++b) {
+		uint64_t target = total * b / buckets;
+		size_t code = std::lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin();
+		if (code > result.bounds.back() && code < distinct) {
+			result.bounds.push_back(code);
+		}
+	}
+	result.bounds.push_back(distinct);
+	for (size_t b = 0; b + 1 < result.bounds.size(); ++b) {
+		result.counts.push_back(cumulative[result.bounds[b + 1]] - cumulative[result.bounds[b]]);
+	}
+	return result;
+}
+
+/**
+	Estimated number of rows with a code in [first, second), assuming rows are spread evenly over the codes of a bucket.
+*/
+double estimate(const uint64_t *bounds, const uint64_t *counts, size_t buckets, size_t first, size_t second) {
+	double rows = 0;
+	for (size_t b = 0; b < buckets; ++b) {
+		size_t from = std::max<size_t>(first, bounds[b]);
+		size_t to = std::min<size_t>(second, bounds[b + 1]);
+		if (from < to) {
+			rows += (double)counts[b] * (to - from) / (bounds[b + 1] - bounds[b]);
+		}
+	}
+	return rows;
+}
+
+/**
+	Computes all statistics of a Dictionary compressed column (see Dictionary::compress).
+*/
+template <typename D, typename C>
+columnStatistics<D> compute(const std::pair<std::vector<D>, std::vector<C>> &compressed, const std::vector<uint8_t> &nulls = {},
+                            size_t buckets = HISTOGRAM_BUCKETS) {
+	const auto &dictionary = compressed.first;
+	columnStatistics<D> stats;
+	stats.rows = compressed.second.size();
+	stats.distinct = dictionary.size();
+	stats.cumulative = countCodes(compressed.second, dictionary.size(), nulls);
+	stats.nullCount = stats.rows - stats.cumulative.back();
+	stats.buckets = equiDepth(stats.cumulative, buckets);
+	bool first = true;
+	for (size_t code = 0; code < dictionary.size(); ++code) {
+		if (stats.frequency(code) == 0) {
+			continue;
+		}
+		if (first) {
+			stats.min = dictionary[code];
+			first = false;
+		}
+		stats.max = dictionary[code];
+		if constexpr (std::is_arithmetic_v<D>) {
+			stats.sum += (double)dictionary[code] * stats.frequency(code);
+		}
+	}
+	return stats;
+}
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Number of rows equal to value: one binary search in the dictionary and one lookup.
+*/
+template <typename D, typename C>
+size_t count_where_op_equal(const std::pair<std::vector<D>, std::vector<C>> &compressed, const columnStatistics<D> &stats, const D &value) {
+	auto it = std::lower_bound(compressed.first.begin(), compressed.first.end(), value);
+	if (it == compressed.first.end() || !(*it == value)) {
+		return 0;
+	}
+	return stats.frequency(it - compressed.first.begin());
+}
+
+/**
+	Number of rows in [from, to) without touching the attribute vector.
+*/
+template <typename D, typename C>
+size_t count_where_op_range(const std::pair<std::vector<D>, std::vector<C>> &compressed, const columnStatistics<D> &stats,
+                            std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = Dictionary::code_range(compressed.first, from, to);
+	return stats.count(first, second);
+}
+
+template <typename D>
+double avg_op(const columnStatistics<D> &stats) {
+	return stats.rows == stats.nullCount ? 0 : stats.sum / (stats.rows - stats.nullCount);
+}
+
+/**
+	Exact fraction of rows matching the predicate, evaluated once per dictionary entry.
+*/
+template <typename D, typename C>
+double selectivity(const std::pair<std::vector<D>, std::vector<C>> &compressed, const columnStatistics<D> &stats, std::function<bool (D)> predicate) {
+	size_t matches = 0;
+	for (size_t code = 0; code < compressed.first.size(); ++code) {
+		if (predicate(compressed.first[code])) {
+			matches += stats.frequency(code);
+		}
+	}
+	return stats.rows == 0 ? 0 : (double)matches / stats.rows;
+}
+
+/**
+	Estimated fraction of rows in [from, to) from the histogram alone.
+*/
+template <typename D, typename C>
+double estimate_selectivity_range(const std::pair<std::vector<D>, std::vector<C>> &compressed, const columnStatistics<D> &stats,
+                                  std::optional<D> from, std::optional<D> to) {
+	auto [first, second] = Dictionary::code_range(compressed.first, from, to);
+	double rows = estimate(stats.buckets.bounds.data(), stats.buckets.counts.data(), stats.buckets.counts.size(), first, second);
+	return stats.rows == 0 ? 0 : rows / stats.rows;
+}
+
+/**
+	Returns all values matching the predicate, using where_copy_op for unselective and where_view_op for selective predicates.
+*/
+template <typename D, typename C>
+std::vector<D> where_op(std::pair<std::vector<D>, std::vector<C>> &compressed, const columnStatistics<D> &stats, std::function<bool (D)> predicate) {
+	if (selectivity(compressed, stats, predicate) > COPY_SELECTIVITY) {
+		return Dictionary::where_copy_op(compressed, predicate);
+	}
+	return Dictionary::where_view_op(compressed, predicate);
+}
+
+} // end namespace Statistics
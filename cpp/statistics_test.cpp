@@ -0,0 +1,69 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "allocator.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "statistics.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::vector<int> column;
+	for (int i = 0; i < 10000; ++i) {
+		// Skewed: half of the rows are 0, the rest spread over 1..499
+		column.push_back(i % 2 == 0 ? 0 : (i * 7) % 499 + 1);
+	}
+	auto compressedColumn = Dictionary::compress<int, uint16_t>(column);
+	std::cout << "#### TEST COMPUTE ####" << std::endl;
+	{
+		auto stats = Statistics::compute(compressedColumn);
+		assert(stats.rows == 10000 && stats.nullCount == 0 && stats.distinct == 500);
+		assert(stats.min == 0 && stats.max == 499);
+		assert(stats.frequency(0) == 5000);
+		double sum = 0;
+		for (auto v : column) {
+			sum += v;
+		}
+		assert(stats.sum == sum);
+		assert(std::abs(Statistics::avg_op(stats) - Dictionary::avg_op(compressedColumn)) < 0.01);
+
+		// The heavy hitter gets a bucket of its own, all other buckets hold about the same number of rows
+		assert(stats.buckets.bounds.front() == 0 && stats.buckets.bounds.back() == 500);
+		assert(stats.buckets.bounds[1] == 1);
+		for (size_t b = 1; b < stats.buckets.counts.size(); ++b) {
+			assert(stats.buckets.counts[b] < 2 * 5000 / (Statistics::HISTOGRAM_BUCKETS / 2));
+		}
+
+		std::vector<uint8_t> nulls(column.size(), 0);
+		nulls[0] = nulls[1] = 1;
+		auto nullStats = Statistics::compute(compressedColumn, nulls);
+		assert(nullStats.nullCount == 2 && nullStats.frequency(0) == 4999);
+	}
+	std::cout << "#### TEST OPS ####" << std::endl;
+	{
+		auto stats = Statistics::compute(compressedColumn);
+		assert(Statistics::count_where_op_equal(compressedColumn, stats, 0) == 5000);
+		assert(Statistics::count_where_op_equal(compressedColumn, stats, 1000) == 0);
+		for (auto [from, to] : {std::pair(0, 1), std::pair(10, 200), std::pair(250, 1000)}) {
+			size_t expected = Dictionary::count_where_op_range<int, uint16_t>(compressedColumn, from, to);
+			assert((Statistics::count_where_op_range<int, uint16_t>(compressedColumn, stats, from, to) == expected));
+			double estimated = Statistics::estimate_selectivity_range<int, uint16_t>(compressedColumn, stats, from, to);
+			assert(std::abs(estimated * column.size() - expected) < 0.02 * column.size());
+		}
+
+		std::function<bool(int)> selective = [](int v) { return v == 7; };
+		std::function<bool(int)> unselective = [](int v) { return v < 250; };
+		assert(Statistics::selectivity(compressedColumn, stats, selective) < Statistics::COPY_SELECTIVITY);
+		assert(Statistics::selectivity(compressedColumn, stats, unselective) > Statistics::COPY_SELECTIVITY);
+		assert(Statistics::where_op(compressedColumn, stats, selective) == Dictionary::where_view_op(compressedColumn, selective));
+		assert(Statistics::where_op(compressedColumn, stats, unselective) == Dictionary::where_copy_op(compressedColumn, unselective));
+	}
+	return 0;
+}
@@ -0,0 +1,791 @@
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Storage
+{
+
+/**
+	On-disk layout (native endianness, every section aligned to ALIGNMENT bytes):
+		fileHeader
+		sections of column 0, column 1, ...
+		columnEntry[columnCount] (the directory, offset stored in fileHeader)
+	Files are opened with mmap and queried in place, nothing is deserialized on open.
+	A column may be split into several entries (segments) with the same name, one per row group (see RowGroup).
+*/
+const char MAGIC[8] = {'T', 'U', 'C', 'O', 'L', 'S', 'T', 'R'};
+const uint32_t VERSION = 3;
+const size_t ALIGNMENT = 64;
+const size_t MAX_NAME = 48;
+const size_t MAX_SECTIONS = 8;
+
+enum class Codec : uint8_t {
+	Dictionary = 1,
+	Huffman = 2,
+};
+
+enum class ValueType : uint8_t {
+	Int32 = 1,
+	Int64 = 2,
+	Float = 3,
+	Double = 4,
+	Date16 = 5,
+	Date32 = 6,
+	String = 7,
+};
+
+/**
+	Section slots per codec. Strings take two slots (offsets, bytes), fixed-width values one.
+*/
+enum Section : uint8_t {
+	// Dictionary and Huffman
+	DictionaryValues = 0,
+	DictionaryBytes = 1,
+	// Dictionary
+	AttributeVector = 2,
+	// One bit per row (1 = NULL), only present if nullCount > 0
+	Nulls = 3,
+	// Statistics::columnStatistics: prefix counts per code and the equi-depth histogram
+	Frequencies = 4,
+	HistogramBounds = 5,
+	HistogramCounts = 6,
+	// Huffman
+	HuffmanCodes = 2,
+	HuffmanBlocks = 3,
+	LowerBounds = 4,
+	LowerBoundBytes = 5,
+	UpperBounds = 6,
+	UpperBoundBytes = 7,
+};
+
+struct fileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t columnCount;
+	uint64_t directoryOffset;
+	uint8_t padding[40];
+};
+static_assert(sizeof(fileHeader) == ALIGNMENT, "fileHeader must fill one aligned block");
+
+struct sectionEntry {
+	uint64_t offset;
+	uint64_t length;
+};
+
+struct columnEntry {
+	char name[MAX_NAME];
+	Codec codec;
+	ValueType valueType;
+	// Bytes per code in the attribute vector (Dictionary only)
+	uint8_t codeWidth;
+	uint8_t padding;
+	// Index of the row group this segment belongs to, 0 for unsegmented columns
+	uint32_t rowGroup;
+	uint64_t rows;
+	uint64_t nullCount;
+	// Number of dictionary entries
+	uint64_t dictionarySize;
+	// Number of Huffman blocks
+	uint64_t blocks;
+	// Sum of all non-NULL values (Dictionary columns of arithmetic type only)
+	double sum;
+	sectionEntry sections[MAX_SECTIONS];
+};
+
+template <typename D>
+constexpr ValueType valueType() {
+	if constexpr (std::is_same_v<D, int32_t>) return ValueType::Int32;
+	else if constexpr (std::is_same_v<D, int64_t>) return ValueType::Int64;
+	else if constexpr (std::is_same_v<D, float>) return ValueType::Float;
+	else if constexpr (std::is_same_v<D, double>) return ValueType::Double;
+	else if constexpr (std::is_same_v<D, Date::date16>) return ValueType::Date16;
+	else if constexpr (std::is_same_v<D, Date::date32>) return ValueType::Date32;
+	else {
+		static_assert(std::is_same_v<D, std::string>, "Unsupported column type");
+		return ValueType::String;
+	}
+}
+
+// ---------------------- VIEWS ------------------ //
+
+/**
+	Fixed-width values read straight from the mapping.
+*/
+template <typename D>
+struct values {
+	const D *data = nullptr;
+	size_t size = 0;
+
+	D operator[](size_t i) const { return data[i]; }
+};
+
+/**
+	Strings are stored as size + 1 offsets into one byte section and returned as views into the mapping.
+*/
+template <>
+struct values<std::string> {
+	const uint64_t *offsets = nullptr;
+	const char *bytes = nullptr;
+	size_t size = 0;
+
+	std::string_view operator[](size_t i) const { return std::string_view(bytes + offsets[i], offsets[i + 1] - offsets[i]); }
+};
+
+template <typename D, typename C>
+struct dictionaryView {
+	values<D> dictionary;
+	const C *attributeVector = nullptr;
+	size_t rows = 0;
+	// Null bitmap, nullptr if the column has no NULLs
+	const uint64_t *nulls = nullptr;
+	size_t nullCount = 0;
+	// Statistics (see Statistics::columnStatistics)
+	const uint64_t *cumulative = nullptr;
+	const uint64_t *histogramBounds = nullptr;
+	const uint64_t *histogramCounts = nullptr;
+	size_t buckets = 0;
+	double sum = 0;
+
+	size_t frequency(size_t code) const { return cumulative[code + 1] - cumulative[code]; }
+
+	bool isNull(size_t i) const { return nulls != nullptr && (nulls[i / 64] >> (i % 64)) & 1; }
+};
+
+template <typename D>
+struct huffmanView {
+	values<D> dictionary;
+	// Code of dictionary entry i as std::bitset<64>::to_ullong()
+	const uint64_t *codes = nullptr;
+	const uint64_t *blocks = nullptr;
+	size_t blockCount = 0;
+	values<D> lowerBounds;
+	values<D> upperBounds;
+	size_t rows = 0;
+};
+
+// ---------------------- WRITER ------------------ //
+
+/**
+	Writes compressed columns into one file. Call close() (or let the destructor do it) to write the directory.
+*/
+class Writer
+{
+public:
+	Writer(const std::string &filePath) : file(filePath, std::ios::binary | std::ios::trunc) {
+		if (!file) {
+			throw std::runtime_error("Cannot open " + filePath + " for writing");
+		}
+		fileHeader header = {};
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	}
+
+	~Writer() {
+		if (!closed) {
+			close();
+		}
+	}
+
+	/**
+		Stores a Dictionary compressed column (see Dictionary::compress).
+		Codes are narrowed to the smallest width that holds the dictionary.
+		Optionally the column is one segment of a row group and has NULLs (one byte per row, 1 = NULL).
+		The codes of NULL rows are stored as they are, queries mask them with the null bitmap.
+		Statistics (per-code counts, histogram, sum) are computed with one extra pass over the codes.
+	*/
+	template <typename D, typename C>
+	void addDictionaryColumn(const std::string &name, const std::pair<std::vector<D>, std::vector<C>> &compressed,
+	                         uint32_t rowGroup = 0, const std::vector<uint8_t> &nulls = {}) {
+		auto entry = makeEntry<D>(name, Codec::Dictionary, compressed.second.size());
+		entry.dictionarySize = compressed.first.size();
+		entry.rowGroup = rowGroup;
+		writeValues(entry, DictionaryValues, DictionaryBytes, compressed.first);
+		size_t size = compressed.first.size();
+		if (size <= (size_t(1) << 8)) {
+			writeCodes<uint8_t>(entry, compressed.second);
+		}
+		else if (size <= (size_t(1) << 16)) {
+			writeCodes<uint16_t>(entry, compressed.second);
+		}
+		else if (size <= (size_t(1) << 32)) {
+			writeCodes<uint32_t>(entry, compressed.second);
+		}
+		else {
+			writeCodes<uint64_t>(entry, compressed.second);
+		}
+		std::vector<uint64_t> bitmap((nulls.size() + 63) / 64, 0);
+		for (size_t i = 0; i < nulls.size(); ++i) {
+			if (nulls[i]) {
+				bitmap[i / 64] |= uint64_t(1) << (i % 64);
+				++entry.nullCount;
+			}
+		}
+		if (entry.nullCount > 0) {
+			writeSection(entry, Nulls, bitmap.data(), bitmap.size() * sizeof(uint64_t));
+		}
+		auto stats = Statistics::compute(compressed, nulls);
+		entry.sum = stats.sum;
+		writeSection(entry, Frequencies, stats.cumulative.data(), stats.cumulative.size() * sizeof(uint64_t));
+		writeSection(entry, HistogramBounds, stats.buckets.bounds.data(), stats.buckets.bounds.size() * sizeof(uint64_t));
+		writeSection(entry, HistogramCounts, stats.buckets.counts.data(), stats.buckets.counts.size() * sizeof(uint64_t));
+		entries.push_back(entry);
+	}
+
+	/**
+		Stores a Huffman compressed column (see Huffman::compress).
+	*/
+	template <typename D>
+	void addHuffmanColumn(const std::string &name, const Huffman::compressedData<D, 64> &compressed, size_t rows) {
+		auto entry = makeEntry<D>(name, Codec::Huffman, rows);
+		std::vector<D> dictionary;
+		std::vector<uint64_t> codes;
+		for (auto const& [value, code] : compressed.dictionary) {
+			dictionary.push_back(value);
+		}
+		std::sort(dictionary.begin(), dictionary.end());
+		for (const auto &value : dictionary) {
+			codes.push_back(compressed.dictionary.at(value).to_ullong());
+		}
+		entry.dictionarySize = dictionary.size();
+		writeValues(entry, DictionaryValues, DictionaryBytes, dictionary);
+		writeSection(entry, HuffmanCodes, codes.data(), codes.size() * sizeof(uint64_t));
+
+		std::vector<uint64_t> blocks;
+		blocks.reserve(compressed.compressed.size());
+		for (const auto &block : compressed.compressed) {
+			blocks.push_back(block.to_ullong());
+		}
+		entry.blocks = blocks.size();
+		writeSection(entry, HuffmanBlocks, blocks.data(), blocks.size() * sizeof(uint64_t));
+
+		std::vector<D> lower, upper;
+		for (const auto &bound : compressed.bounds) {
+			lower.push_back(bound.first);
+			upper.push_back(bound.second);
+		}
+		writeValues(entry, LowerBounds, LowerBoundBytes, lower);
+		writeValues(entry, UpperBounds, UpperBoundBytes, upper);
+		entries.push_back(entry);
+	}
+
+	void close() {
+		pad();
+		fileHeader header = {};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.columnCount = entries.size();
+		header.directoryOffset = file.tellp();
+		file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(columnEntry));
+		file.seekp(0);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.close();
+		closed = true;
+	}
+
+private:
+	std::ofstream file;
+	std::vector<columnEntry> entries;
+	bool closed = false;
+
+	template <typename D>
+	columnEntry makeEntry(const std::string &name, Codec codec, size_t rows) {
+		if (name.size() >= MAX_NAME) {
+			throw std::invalid_argument("Column name " + name + " is longer than " + std::to_string(MAX_NAME - 1) + " characters");
+		}
+		columnEntry entry = {};
+		std::memcpy(entry.name, name.data(), name.size());
+		entry.codec = codec;
+		entry.valueType = valueType<D>();
+		entry.rows = rows;
+		return entry;
+	}
+
+	void pad() {
+		static const char zeros[ALIGNMENT] = {};
+		size_t position = file.tellp();
+		size_t padding = (ALIGNMENT - position % ALIGNMENT) % ALIGNMENT;
+		file.write(zeros, padding);
+	}
+
+	void writeSection(columnEntry &entry, uint8_t section, const void *data, size_t length) {
+		pad();
+		entry.sections[section].offset = file.tellp();
+		entry.sections[section].length = length;
+		file.write(reinterpret_cast<const char *>(data), length);
+	}
+
+	template <typename D>
+	void writeValues(columnEntry &entry, uint8_t section, uint8_t bytesSection, const std::vector<D> &data) {
+		if constexpr (std::is_same_v<D, std::string>) {
+			std::vector<uint64_t> offsets;
+			offsets.reserve(data.size() + 1);
+			std::string bytes;
+			offsets.push_back(0);
+			for (const auto &value : data) {
+				bytes += value;
+				offsets.push_back(bytes.size());
+			}
+			writeSection(entry, section, offsets.data(), offsets.size() * sizeof(uint64_t));
+			writeSection(entry, bytesSection, bytes.data(), bytes.size());
+		}
+		else {
+			static_assert(std::is_trivially_copyable_v<D>, "Values must be trivially copyable");
+			writeSection(entry, section, data.data(), data.size() * sizeof(D));
+		}
+	}
+
+	template <typename T, typename C>
+	void writeCodes(columnEntry &entry, const std::vector<C> &attributeVector) {
+		entry.codeWidth = sizeof(T);
+		if constexpr (std::is_same_v<T, C>) {
+			writeSection(entry, AttributeVector, attributeVector.data(), attributeVector.size() * sizeof(C));
+		}
+		else {
+			std::vector<T> narrowed(attributeVector.begin(), attributeVector.end());
+			writeSection(entry, AttributeVector, narrowed.data(), narrowed.size() * sizeof(T));
+		}
+	}
+};
+
+// ---------------------- READER ------------------ //
+
+/**
+	A read-only memory mapping of a column file. Views returned by the accessors
+	point into the mapping and are valid as long as the File lives.
+*/
+class File
+{
+public:
+	File(const std::string &filePath) {
+		int fd = ::open(filePath.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("Cannot open " + filePath);
+		}
+		struct stat info;
+		if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(fileHeader)) {
+			::close(fd);
+			throw std::runtime_error(filePath + " is not a column file");
+		}
+		length = info.st_size;
+		void *mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED) {
+			throw std::runtime_error("Cannot map " + filePath);
+		}
+		base = static_cast<const char *>(mapping);
+		header = reinterpret_cast<const fileHeader *>(base);
+		if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+		        header->directoryOffset % ALIGNMENT != 0 || header->directoryOffset > length ||
+		        header->columnCount * sizeof(columnEntry) > length - header->directoryOffset) {
+			munmap(const_cast<char *>(base), length);
+			throw std::runtime_error(filePath + " is not a version " + std::to_string(VERSION) + " column file");
+		}
+		directory = reinterpret_cast<const columnEntry *>(base + header->directoryOffset);
+		for (size_t i = 0; i < columnCount(); ++i) {
+			if (!valid(directory[i])) {
+				munmap(const_cast<char *>(base), length);
+				throw std::runtime_error(filePath + " has a corrupt entry for column " + std::to_string(i));
+			}
+		}
+	}
+
+	File(const File &) = delete;
+	File &operator=(const File &) = delete;
+
+	~File() {
+		munmap(const_cast<char *>(base), length);
+	}
+
+	size_t columnCount() const {
+		return header->columnCount;
+	}
+
+	const columnEntry &entry(size_t i) const {
+		return directory[i];
+	}
+
+	const columnEntry &entry(const std::string &name) const {
+		for (size_t i = 0; i < columnCount(); ++i) {
+			if (name == directory[i].name) {
+				return directory[i];
+			}
+		}
+		throw std::invalid_argument("No column named " + name);
+	}
+
+	/**
+		Indices of all entries named `name`, i.e. the segments of a column in row group order.
+	*/
+	std::vector<size_t> segments(const std::string &name) const {
+		std::vector<size_t> indices;
+		for (size_t i = 0; i < columnCount(); ++i) {
+			if (name == directory[i].name) {
+				indices.push_back(i);
+			}
+		}
+		std::stable_sort(indices.begin(), indices.end(), [this](size_t a, size_t b) {
+			return directory[a].rowGroup < directory[b].rowGroup;
+		});
+		return indices;
+	}
+
+	template <typename D, typename C>
+	dictionaryView<D, C> dictionaryColumn(const std::string &name) const {
+		return dictionaryColumn<D, C>(checkedIndex<D>(name, Codec::Dictionary));
+	}
+
+	template <typename D, typename C>
+	dictionaryView<D, C> dictionaryColumn(size_t index) const {
+		const auto &column = entry(index);
+		if (column.codec != Codec::Dictionary || column.valueType != valueType<D>()) {
+			throw std::invalid_argument("Column " + std::string(column.name) + " has a different codec or type");
+		}
+		if (column.codeWidth != sizeof(C)) {
+			throw std::invalid_argument("Column " + std::string(column.name) + " stores " + std::to_string(column.codeWidth) + " byte codes");
+		}
+		dictionaryView<D, C> view;
+		view.dictionary = valuesOf<D>(column, DictionaryValues, DictionaryBytes, column.dictionarySize);
+		view.attributeVector = reinterpret_cast<const C *>(base + column.sections[AttributeVector].offset);
+		view.rows = column.rows;
+		view.nullCount = column.nullCount;
+		if (column.nullCount > 0) {
+			view.nulls = reinterpret_cast<const uint64_t *>(base + column.sections[Nulls].offset);
+		}
+		view.cumulative = reinterpret_cast<const uint64_t *>(base + column.sections[Frequencies].offset);
+		view.histogramBounds = reinterpret_cast<const uint64_t *>(base + column.sections[HistogramBounds].offset);
+		view.histogramCounts = reinterpret_cast<const uint64_t *>(base + column.sections[HistogramCounts].offset);
+		view.buckets = column.sections[HistogramCounts].length / sizeof(uint64_t);
+		view.sum = column.sum;
+		return view;
+	}
+
+	template <typename D>
+	huffmanView<D> huffmanColumn(const std::string &name) const {
+		const auto &column = entry(checkedIndex<D>(name, Codec::Huffman));
+		huffmanView<D> view;
+		view.dictionary = valuesOf<D>(column, DictionaryValues, DictionaryBytes, column.dictionarySize);
+		view.codes = reinterpret_cast<const uint64_t *>(base + column.sections[HuffmanCodes].offset);
+		view.blocks = reinterpret_cast<const uint64_t *>(base + column.sections[HuffmanBlocks].offset);
+		view.blockCount = column.blocks;
+		view.lowerBounds = valuesOf<D>(column, LowerBounds, LowerBoundBytes, column.blocks);
+		view.upperBounds = valuesOf<D>(column, UpperBounds, UpperBoundBytes, column.blocks);
+		view.rows = column.rows;
+		return view;
+	}
+
+private:
+	const char *base = nullptr;
+	size_t length = 0;
+	const fileHeader *header = nullptr;
+	const columnEntry *directory = nullptr;
+
+	/**
+		True if a section lies in the mapping, is aligned and holds exactly `expected` bytes.
+	*/
+	bool validSection(const sectionEntry &section, uint64_t expected) const {
+		return section.offset % ALIGNMENT == 0 && section.offset <= length && section.length <= length - section.offset &&
+		       section.length == expected;
+	}
+
+	/**
+		Checks the sections of `size` values. String offsets have to ascend and end within their byte section.
+	*/
+	bool validValues(const columnEntry &column, uint8_t section, uint8_t bytesSection, uint64_t size) const {
+		const uint64_t width[] = {0, sizeof(int32_t), sizeof(int64_t), sizeof(float), sizeof(double),
+		                          sizeof(Date::date16), sizeof(Date::date32)};
+		if (column.valueType != ValueType::String) {
+			return size <= length / width[(size_t)column.valueType] &&
+			       validSection(column.sections[section], size * width[(size_t)column.valueType]);
+		}
+		const auto &bytes = column.sections[bytesSection];
+		if (size >= length / sizeof(uint64_t) || !validSection(column.sections[section], (size + 1) * sizeof(uint64_t)) ||
+		        !validSection(bytes, bytes.length)) {
+			return false;
+		}
+		const uint64_t *offsets = reinterpret_cast<const uint64_t *>(base + column.sections[section].offset);
+		for (size_t i = 0; i < size; ++i) {
+			if (offsets[i] > offsets[i + 1]) {
+				return false;
+			}
+		}
+		return offsets[0] == 0 && offsets[size] <= bytes.length;
+	}
+
+	/**
+		Checks that every section of a directory entry lies in the mapping and is as long as its counts require,
+		so the views never read past the file.
+	*/
+	bool valid(const columnEntry &column) const {
+		if (std::memchr(column.name, '\0', MAX_NAME) == nullptr ||
+		        column.valueType < ValueType::Int32 || column.valueType > ValueType::String) {
+			return false;
+		}
+		for (const auto &section : column.sections) {
+			if (!validSection(section, section.length)) {
+				return false;
+			}
+		}
+		const auto &sections = column.sections;
+		if (column.codec == Codec::Dictionary) {
+			uint64_t width = column.codeWidth;
+			if ((width != 1 && width != 2 && width != 4 && width != 8) || column.rows > length / width ||
+			        column.dictionarySize >= length / sizeof(uint64_t) || column.nullCount > column.rows) {
+				return false;
+			}
+			uint64_t buckets = sections[HistogramCounts].length / sizeof(uint64_t);
+			return validValues(column, DictionaryValues, DictionaryBytes, column.dictionarySize) &&
+			       validSection(sections[AttributeVector], column.rows * width) &&
+			       (column.nullCount == 0 || validSection(sections[Nulls], (column.rows + 63) / 64 * sizeof(uint64_t))) &&
+			       validSection(sections[Frequencies], (column.dictionarySize + 1) * sizeof(uint64_t)) &&
+			       validSection(sections[HistogramCounts], buckets * sizeof(uint64_t)) &&
+			       validSection(sections[HistogramBounds], (buckets + 1) * sizeof(uint64_t));
+		}
+		if (column.codec == Codec::Huffman) {
+			if (column.dictionarySize >= length / sizeof(uint64_t) || column.blocks >= length / sizeof(uint64_t)) {
+				return false;
+			}
+			return validValues(column, DictionaryValues, DictionaryBytes, column.dictionarySize) &&
+			       validSection(sections[HuffmanCodes], column.dictionarySize * sizeof(uint64_t)) &&
+			       validSection(sections[HuffmanBlocks], column.blocks * sizeof(uint64_t)) &&
+			       validValues(column, LowerBounds, LowerBoundBytes, column.blocks) &&
+			       validValues(column, UpperBounds, UpperBoundBytes, column.blocks);
+		}
+		return false;
+	}
+
+	template <typename D>
+	size_t checkedIndex(const std::string &name, Codec codec) const {
+		for (size_t i = 0; i < columnCount(); ++i) {
+			if (name == directory[i].name) {
+				if (directory[i].codec != codec || directory[i].valueType != valueType<D>()) {
+					throw std::invalid_argument("Column " + name + " has a different codec or type");
+				}
+				return i;
+			}
+		}
+		throw std::invalid_argument("No column named " + name);
+	}
+
+	template <typename D>
+	values<D> valuesOf(const columnEntry &column, uint8_t section, uint8_t bytesSection, size_t size) const {
+		values<D> result;
+		result.size = size;
+		if constexpr (std::is_same_v<D, std::string>) {
+			result.offsets = reinterpret_cast<const uint64_t *>(base + column.sections[section].offset);
+			result.bytes = base + column.sections[bytesSection].offset;
+		}
+		else {
+			result.data = reinterpret_cast<const D *>(base + column.sections[section].offset);
+		}
+		return result;
+	}
+};
+
+// ---------------------- OPS ------------------ //
+
+/**
+	Calls fn(row) for every NULL row of the view. The ops scan all codes branch-free
+	and correct their result for the (usually few) NULL rows afterwards.
+*/
+template <typename D, typename C, typename F>
+void for_each_null(const dictionaryView<D, C> &view, F fn) {
+	if (view.nulls == nullptr) {
+		return;
+	}
+	for (size_t word = 0; word < (view.rows + 63) / 64; ++word) {
+		uint64_t bits = view.nulls[word];
+		while (bits != 0) {
+			fn(word * 64 + __builtin_ctzll(bits));
+			bits &= bits - 1;
+		}
+	}
+}
+
+/**
+	Materializes a stored Dictionary column. NULL rows hold an arbitrary value of the column.
+*/
+template <typename D, typename C>
+std::vector<D> decompress(const dictionaryView<D, C> &view) {
+	std::vector<D> decompressed;
+	decompressed.reserve(view.rows);
+	for (size_t i = 0; i < view.rows; ++i) {
+		decompressed.push_back(D(view.dictionary[view.attributeVector[i]]));
+	}
+	return decompressed;
+}
+
+template <typename D, typename C>
+std::vector<D> partial_decompress(const dictionaryView<D, C> &view, const std::vector<size_t> &indices) {
+	std::vector<D> decompressed;
+	decompressed.reserve(indices.size());
+	for (auto index : indices) {
+		decompressed.push_back(D(view.dictionary[view.attributeVector[index]]));
+	}
+	return decompressed;
+}
+
+/**
+	Counts all values matching the predicate. The predicate receives D (std::string_view for strings)
+	and is evaluated once per dictionary entry.
+*/
+template <typename D, typename C, typename P>
+size_t count_where_op(const dictionaryView<D, C> &view, P predicate) {
+	std::vector<bool> matches(view.dictionary.size);
+	for (size_t code = 0; code < view.dictionary.size; ++code) {
+		matches[code] = predicate(view.dictionary[code]);
+	}
+	size_t count = 0;
+	for (size_t i = 0; i < view.rows; ++i) {
+		count += matches[view.attributeVector[i]];
+	}
+	for_each_null(view, [&](size_t i) {
+		count -= matches[view.attributeVector[i]];
+	});
+	return count;
+}
+
+/**
+	First code whose dictionary value is not less than value (binary search on the stored, sorted dictionary).
+*/
+template <typename D, typename C, typename V>
+size_t lower_bound_code(const dictionaryView<D, C> &view, const V &value) {
+	size_t first = 0, count = view.dictionary.size;
+	while (count > 0) {
+		size_t step = count / 2;
+		if (view.dictionary[first + step] < value) {
+			first += step + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+	return first;
+}
+
+template <typename D, typename C, typename V>
+std::pair<size_t, size_t> code_range(const dictionaryView<D, C> &view, std::optional<V> from, std::optional<V> to) {
+	size_t first = from ? lower_bound_code(view, *from) : 0;
+	size_t second = to ? lower_bound_code(view, *to) : view.dictionary.size;
+	return std::pair(first, std::max(first, second));
+}
+
+/**
+	Counts all values in [from, to): two binary searches on the dictionary and one lookup in the stored per-code counts.
+*/
+template <typename D, typename C, typename V>
+size_t count_where_op_range(const dictionaryView<D, C> &view, std::optional<V> from, std::optional<V> to) {
+	auto [first, second] = code_range(view, from, to);
+	return view.cumulative[second] - view.cumulative[first];
+}
+
+template <typename D, typename C, typename V>
+size_t count_where_op_equal(const dictionaryView<D, C> &view, const V &value) {
+	size_t code = lower_bound_code(view, value);
+	if (code == view.dictionary.size || !(view.dictionary[code] == value)) {
+		return 0;
+	}
+	return view.frequency(code);
+}
+
+/**
+	Estimated fraction of rows in [from, to) from the stored histogram.
+*/
+template <typename D, typename C, typename V>
+double estimate_selectivity_range(const dictionaryView<D, C> &view, std::optional<V> from, std::optional<V> to) {
+	auto [first, second] = code_range(view, from, to);
+	double rows = Statistics::estimate(view.histogramBounds, view.histogramCounts, view.buckets, first, second);
+	return view.rows == 0 ? 0 : rows / view.rows;
+}
+
+template <typename D, typename C>
+size_t sum_op(const dictionaryView<D, C> &view) {
+	size_t total_sum = 0;
+	for (size_t code = 0; code < view.dictionary.size; ++code) {
+		total_sum += view.dictionary[code] * view.frequency(code);
+	}
+	return total_sum;
+}
+
+template <typename D, typename C>
+double avg_op(const dictionaryView<D, C> &view) {
+	return view.rows == view.nullCount ? 0 : view.sum / (view.rows - view.nullCount);
+}
+
+/**
+	Decodes one stored Huffman block into dictionary indices. Uses the same prefix walk as Huffman::decompressBlock,
+	with a lookup from code to dictionary index that is built once per query.
+*/
+void decodeHuffmanBlock(uint64_t block, const std::unordered_map<uint64_t, size_t> &reverseDictionary, std::vector<size_t> &out) {
+	std::bitset<64> bits(block);
+	std::bitset<64> mask;
+	size_t shift = 0;
+	for (size_t i = 0; i < 64; ++i) {
+		mask.set(63 - i, 1);
+		auto search = ((bits & mask) << shift);
+		if (search.none() && !bits.none()) {
+			continue;
+		}
+		auto it = reverseDictionary.find(search.to_ullong());
+		if (it != reverseDictionary.end()) {
+			shift = i + 1;
+			mask.reset();
+			out.push_back(it->second);
+		}
+	}
+}
+
+template <typename D>
+std::unordered_map<uint64_t, size_t> reverseDictionary(const huffmanView<D> &view) {
+	std::unordered_map<uint64_t, size_t> reverse(view.dictionary.size);
+	for (size_t i = 0; i < view.dictionary.size; ++i) {
+		reverse[view.codes[i]] = i;
+	}
+	return reverse;
+}
+
+/**
+	Materializes a stored Huffman column.
+*/
+template <typename D>
+std::vector<D> decompress(const huffmanView<D> &view) {
+	auto reverse = reverseDictionary(view);
+	std::vector<D> decompressed;
+	decompressed.reserve(view.rows);
+	std::vector<size_t> indices;
+	for (size_t b = 0; b < view.blockCount; ++b) {
+		indices.clear();
+		decodeHuffmanBlock(view.blocks[b], reverse, indices);
+		for (auto index : indices) {
+			decompressed.push_back(D(view.dictionary[index]));
+		}
+	}
+	return decompressed;
+}
+
+/**
+	Counts all values equal to value. Blocks whose stored bounds exclude the value are skipped.
+*/
+template <typename D, typename V>
+size_t count_where_op_equal(const huffmanView<D> &view, const V &value) {
+	auto reverse = reverseDictionary(view);
+	size_t count = 0;
+	std::vector<size_t> indices;
+	for (size_t b = 0; b < view.blockCount; ++b) {
+		if (value < view.lowerBounds[b] || view.upperBounds[b] < value) {
+			continue;
+		}
+		indices.clear();
+		decodeHuffmanBlock(view.blocks[b], reverse, indices);
+		for (auto index : indices) {
+			count += view.dictionary[index] == value;
+		}
+	}
+	return count;
+}
+
+} // end namespace Storage
@@ -0,0 +1,150 @@
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include <utility>
+#include <queue>
+#include <cassert>
+#include <bitset>
+#include <algorithm>
+#include <cstdio>
+#include "allocator.cpp"
+#include "date.cpp"
+#include "benchmark.cpp"
+#include "dictionary.cpp"
+#include "huffman.cpp"
+#include "statistics.cpp"
+#include "storage.cpp"
+
+int main(int argc, char const *argv[])
+{
+	std::string storeFile = "/tmp/storage_test.tucol";
+	std::vector<int32_t> ints;
+	std::vector<std::string> strings;
+	std::vector<Date::date16> dates;
+	for (int i = 0; i < 1000; ++i) {
+		ints.push_back((i * 37) % 300);
+		strings.push_back(i % 3 == 0 ? "O" : (i % 3 == 1 ? "F" : "P"));
+		dates.push_back(Date::date16(9000 + i % 50));
+	}
+	auto huffmanColumn = Huffman::compress<int32_t, 64>(ints);
+	Huffman::compressedData<int32_t, 64> huffmanData;
+	huffmanData.dictionary = std::get<0>(huffmanColumn);
+	huffmanData.compressed = std::get<1>(huffmanColumn);
+	huffmanData.bounds = std::get<2>(huffmanColumn);
+	auto huffmanStringColumn = Huffman::compress<std::string, 64>(strings);
+	Huffman::compressedData<std::string, 64> huffmanStringData;
+	huffmanStringData.dictionary = std::get<0>(huffmanStringColumn);
+	huffmanStringData.compressed = std::get<1>(huffmanStringColumn);
+	huffmanStringData.bounds = std::get<2>(huffmanStringColumn);
+
+	std::cout << "#### TEST WRITE ####" << std::endl;
+	{
+		Storage::Writer writer(storeFile);
+		writer.addDictionaryColumn("INTS", Dictionary::compress<int32_t, uint32_t>(ints));
+		writer.addDictionaryColumn("STRINGS", Dictionary::compress<std::string, uint32_t>(strings));
+		writer.addDictionaryColumn("DATES", Dictionary::compress<Date::date16, uint8_t>(dates));
+		writer.addHuffmanColumn("HUFFMAN_INTS", huffmanData, ints.size());
+		writer.addHuffmanColumn("HUFFMAN_STRINGS", huffmanStringData, strings.size());
+	}
+	std::cout << "#### TEST READ ####" << std::endl;
+	{
+		Storage::File file(storeFile);
+		assert(file.columnCount() == 5);
+		for (size_t i = 0; i < file.columnCount(); ++i) {
+			for (const auto &section : file.entry(i).sections) {
+				assert(section.offset % Storage::ALIGNMENT == 0);
+			}
+		}
+		assert(file.entry("INTS").codeWidth == 2);
+		assert(file.entry("STRINGS").codeWidth == 1);
+
+		auto intView = file.dictionaryColumn<int32_t, uint16_t>("INTS");
+		assert(Storage::decompress(intView) == ints);
+		size_t expectedSum = 0;
+		for (auto v : ints) {
+			expectedSum += v;
+		}
+		assert(Storage::sum_op(intView) == expectedSum);
+		assert(Storage::avg_op(intView) == (double)expectedSum / ints.size());
+		assert(intView.buckets > 1 && intView.cumulative[intView.dictionary.size] == ints.size());
+		double estimated = Storage::estimate_selectivity_range<int32_t, uint16_t, int32_t>(intView, 100, 200);
+		assert(estimated > 0.3 && estimated < 0.37);
+		assert((Storage::count_where_op_range<int32_t, uint16_t, int32_t>(intView, 100, 200) ==
+		        (size_t)std::count_if(ints.begin(), ints.end(), [](int32_t v) { return v >= 100 && v < 200; })));
+		std::vector<size_t> indices = {1, 999};
+		std::vector<int32_t> expectedPartial = {ints[1], ints[999]};
+		assert(Storage::partial_decompress(intView, indices) == expectedPartial);
+
+		auto stringView = file.dictionaryColumn<std::string, uint8_t>("STRINGS");
+		assert(Storage::decompress(stringView) == strings);
+		assert(Storage::count_where_op(stringView, [](std::string_view s) { return s == "O"; }) == 334);
+		assert(Storage::count_where_op_equal(stringView, std::string_view("O")) == 334);
+		assert(Storage::count_where_op_equal(stringView, std::string_view("X")) == 0);
+
+		auto dateView = file.dictionaryColumn<Date::date16, uint8_t>("DATES");
+		assert(Storage::decompress(dateView) == dates);
+		assert((Storage::count_where_op_range<Date::date16, uint8_t, Date::date16>(dateView, {}, Date::date16(9010)) == 200));
+
+		auto huffmanView = file.huffmanColumn<int32_t>("HUFFMAN_INTS");
+		assert(Storage::decompress(huffmanView) == ints);
+		assert((Storage::count_where_op_equal(huffmanView, 37) ==
+		        Huffman::count_where_op_equal<int32_t, 64>(huffmanData.dictionary, huffmanData.compressed, huffmanData.bounds, 37)));
+
+		auto huffmanStringView = file.huffmanColumn<std::string>("HUFFMAN_STRINGS");
+		assert(Storage::decompress(huffmanStringView) == strings);
+		assert(Storage::count_where_op_equal(huffmanStringView, std::string_view("P")) == 333);
+
+		bool thrown = false;
+		try {
+			file.dictionaryColumn<int32_t, uint8_t>("INTS");
+		}
+		catch (const std::invalid_argument &e) {
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	std::cout << "#### TEST CORRUPT FILES ####" << std::endl;
+	{
+		std::ifstream in(storeFile, std::ios::binary);
+		std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		Storage::fileHeader header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		auto opens = [&storeFile](const std::string &content) {
+			std::ofstream(storeFile, std::ios::binary | std::ios::trunc) << content;
+			try {
+				Storage::File file(storeFile);
+				return true;
+			}
+			catch (const std::runtime_error &e) {
+				return false;
+			}
+		};
+		assert(opens(bytes));
+		assert(!opens(bytes.substr(0, bytes.size() - 1)));
+
+		// Every column: more rows or dictionary entries than its sections hold, a section past the end of the file
+		for (size_t i = 0; i < header.columnCount; ++i) {
+			size_t position = header.directoryOffset + i * sizeof(Storage::columnEntry);
+			Storage::columnEntry column;
+			std::memcpy(&column, bytes.data() + position, sizeof(column));
+			std::vector<Storage::columnEntry> corrupt(3, column);
+			++corrupt[0].rows;
+			++corrupt[1].dictionarySize;
+			corrupt[2].sections[Storage::DictionaryValues].offset = bytes.size();
+			if (column.codec == Storage::Codec::Huffman) {
+				corrupt[0].rows = column.rows;
+				++corrupt[0].blocks;
+			}
+			for (const auto &entry : corrupt) {
+				std::string content = bytes;
+				std::memcpy(&content[position], &entry, sizeof(entry));
+				assert(!opens(content));
+			}
+		}
+	}
+	std::remove(storeFile.c_str());
+	return 0;
+}